@@ -1,7 +1,14 @@
 #include "bench_utils.hpp"
+#include "randomshake/entropy_source.hpp"
 #include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_compact.hpp"
+#include "randomshake/randomshake_substreams.hpp"
+#include "randomshake/secure_pool.hpp"
 #include <array>
 #include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <memory>
+#include <new>
 
 namespace {
 
@@ -20,17 +27,184 @@ bench_deterministic_csprng_creation(benchmark::State& state)
   }
 }
 
+// Compact CSPRNG defers finalization of the XOF until first use, and squeezes only as many bytes as asked for.
 void
-bench_nondeterministic_csprng_creation(benchmark::State& state)
+bench_compact_csprng_creation(benchmark::State& state)
 {
+  std::array<uint8_t, randomshake::randomshake_compact_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
   for (auto _itr : state) {
-    randomshake::randomshake_t csprng;
+    benchmark::DoNotOptimize(seed);
+    randomshake::randomshake_compact_t<uint64_t> csprng(seed);
 
     benchmark::DoNotOptimize(&csprng);
     benchmark::ClobberMemory();
   }
 }
 
+// Creating a compact CSPRNG and squeezing a 16 -bytes session token, which is all some short-lived sessions ever need.
+void
+bench_compact_csprng_creation_and_first_use(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_compact_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::array<uint8_t, 16> token{};
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(seed);
+    randomshake::randomshake_compact_t csprng(seed);
+    csprng.generate(token);
+
+    benchmark::DoNotOptimize(token);
+    benchmark::ClobberMemory();
+  }
+}
+
+// Same as above, but using `randomshake_t`, which squeezes a whole ratchet period into its internal buffer, at creation.
+void
+bench_deterministic_csprng_creation_and_first_use(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::array<uint8_t, 16> token{};
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(seed);
+    randomshake::randomshake_t csprng(seed);
+    csprng.generate(token);
+
+    benchmark::DoNotOptimize(token);
+    benchmark::ClobberMemory();
+  }
+}
+
+// Deriving a child CSPRNG, per entity, from a common seed, and squeezing 16 -bytes from it.
+void
+bench_substream_derivation_and_first_use(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_substreams_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  const randomshake::randomshake_substreams_t substreams(seed);
+
+  std::array<uint8_t, 16> output{};
+  uint64_t entity_id = 0;
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(entity_id);
+    auto csprng = substreams.substream(entity_id++);
+    csprng.generate(output);
+
+    benchmark::DoNotOptimize(output);
+    benchmark::ClobberMemory();
+  }
+}
+
+#if RANDOMSHAKE_HAS_POSIX_MMAN
+
+// Creating and destroying a CSPRNG instance on the heap, locking it in memory and excluding it from core dumps, one by one. The
+// instance is given page-aligned storage, spanning whole pages, as `mlock` and `madvise` act on whole pages, and the latter
+// fails on an unaligned address.
+void
+bench_individually_locked_csprng_lifecycle(benchmark::State& state)
+{
+  using csprng_t = randomshake::randomshake_t<uint64_t>;
+
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  const auto page_byte_len = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  const size_t storage_byte_len = ((sizeof(csprng_t) + page_byte_len - 1) / page_byte_len) * page_byte_len;
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(seed);
+
+    void* storage = std::aligned_alloc(page_byte_len, storage_byte_len);
+    if (storage == nullptr) {
+      state.SkipWithError("Failed to allocate page-aligned storage");
+      break;
+    }
+    if (::mlock(storage, storage_byte_len) != 0) {
+      std::free(storage); // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+      state.SkipWithError("Failed to lock storage in memory");
+      break;
+    }
+#ifdef MADV_DONTDUMP
+    if (::madvise(storage, storage_byte_len, MADV_DONTDUMP) != 0) {
+      ::munlock(storage, storage_byte_len);
+      std::free(storage); // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+      state.SkipWithError("Failed to exclude storage from core dumps");
+      break;
+    }
+#endif
+
+    auto* csprng = ::new (storage) csprng_t(seed);
+
+    benchmark::DoNotOptimize(csprng);
+    benchmark::ClobberMemory();
+
+    csprng->~csprng_t();
+
+    const bool is_unlocked = ::munlock(storage, storage_byte_len) == 0;
+    std::free(storage); // NOLINT(cppcoreguidelines-no-malloc,hicpp-no-malloc)
+
+    if (!is_unlocked) {
+      state.SkipWithError("Failed to unlock storage");
+      break;
+    }
+  }
+}
+
+// Creating and destroying a CSPRNG instance in a slot of a secure pool, which was locked in memory once, at construction.
+void
+bench_secure_pool_csprng_lifecycle(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::secure_pool_t<randomshake::randomshake_t<uint64_t>> pool(64);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(seed);
+
+    auto csprng = pool.make_unique(seed);
+
+    benchmark::DoNotOptimize(csprng.get());
+    benchmark::ClobberMemory();
+  }
+}
+
+#endif
+
+// Reseeding an existing CSPRNG instance, which is an alternative to creating a new non-deterministically seeded one.
+void
+bench_csprng_reseeding(benchmark::State& state)
+{
+  randomshake::randomshake_t csprng;
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    csprng.reseed();
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::ClobberMemory();
+  }
+}
+
+template<typename source_t>
+void
+bench_nondeterministic_csprng_creation(benchmark::State& state)
+{
+  for (auto _itr : state) {
+    randomshake::randomshake_t csprng(source_t{});
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::ClobberMemory();
+  }
+}
 }
 
 BENCHMARK(bench_deterministic_csprng_creation)
@@ -38,7 +212,43 @@ BENCHMARK(bench_deterministic_csprng_creation)
   ->ComputeStatistics("min", compute_min)
   ->ComputeStatistics("max", compute_max);
 
-BENCHMARK(bench_nondeterministic_csprng_creation)
+BENCHMARK(bench_deterministic_csprng_creation_and_first_use)
+  ->Name("deterministic_csprng/create_and_generate_16B")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_compact_csprng_creation)->Name("compact_csprng/create")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_compact_csprng_creation_and_first_use)
+  ->Name("compact_csprng/create_and_generate_16B")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_substream_derivation_and_first_use)
+  ->Name("substreams/derive_and_generate_16B")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_nondeterministic_csprng_creation<randomshake::default_entropy_source_t>)
   ->Name("non-deterministic_csprng/create")
   ->ComputeStatistics("min", compute_min)
   ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_nondeterministic_csprng_creation<randomshake::random_device_entropy_source_t>)
+  ->Name("non-deterministic_csprng/random_device/create")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_nondeterministic_csprng_creation<randomshake::hardware_mixed_entropy_source_t<>>)
+  ->Name("non-deterministic_csprng/hardware_mixed/create")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_csprng_reseeding)->Name("non-deterministic_csprng/reseed")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+
+#if RANDOMSHAKE_HAS_POSIX_MMAN
+BENCHMARK(bench_individually_locked_csprng_lifecycle)
+  ->Name("deterministic_csprng/individually_locked/create_and_destroy")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_secure_pool_csprng_lifecycle)
+  ->Name("deterministic_csprng/secure_pool/create_and_destroy")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+#endif
@@ -1,8 +1,19 @@
 #include "bench_utils.hpp"
+#include "randomshake/generate_parallel.hpp"
 #include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_batch.hpp"
+#include "randomshake/randomshake_compact.hpp"
+#include "randomshake/randomshake_multilane.hpp"
+#include "randomshake/randomshake_prefetching.hpp"
+#include "randomshake/randomshake_seekable.hpp"
+#include "randomshake/tree_xof.hpp"
+#include <algorithm>
 #include <array>
 #include <benchmark/benchmark.h>
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -31,14 +42,151 @@ bench_csprng_output_generation(benchmark::State& state)
   state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sizeof(result_type)));
 }
 
-template<randomshake::xof_kind_t xof_kind>
+template<typename result_type>
+void
+bench_compact_csprng_output_generation(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_compact_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_compact_t<result_type> csprng(seed);
+  result_type result{};
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(result);
+
+    result ^= csprng();
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sizeof(result_type)));
+}
+
+template<typename result_type, randomshake::refill_mode_t refill_mode>
+void
+bench_prefetching_csprng_output_generation(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_prefetching_t<result_type> csprng(seed, refill_mode);
+  result_type result{};
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(result);
+
+    result ^= csprng();
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sizeof(result_type)));
+}
+
+template<typename result_type>
+void
+bench_csprng_batched_output_generation(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<result_type> csprng(seed);
+
+  constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 1'024UL * 1'024UL; // 1 MB
+  std::vector<result_type> rand_values(RANDOM_OUTPUT_BYTE_LEN / sizeof(result_type), 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_values);
+
+    csprng.generate(std::span(rand_values));
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(RANDOM_OUTPUT_BYTE_LEN));
+}
+
+// Squeezes a 16 -bytes nonce from each of `num_sessions` -many separate CSPRNG instances, one per session.
+template<size_t num_sessions>
+void
+bench_per_session_csprng_nonce_generation(benchmark::State& state)
+{
+  std::vector<std::unique_ptr<randomshake::randomshake_t<>>> csprngs;
+  for (size_t session_idx = 0; session_idx < num_sessions; session_idx++) {
+    std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+    seed.fill(static_cast<uint8_t>(session_idx));
+
+    csprngs.push_back(std::make_unique<randomshake::randomshake_t<>>(seed));
+  }
+
+  constexpr size_t NONCE_BYTE_LEN = 16;
+  std::vector<uint8_t> nonces(num_sessions * NONCE_BYTE_LEN, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(csprngs);
+    benchmark::DoNotOptimize(nonces);
+
+    for (size_t session_idx = 0; session_idx < num_sessions; session_idx++) {
+      csprngs[session_idx]->generate(std::span(nonces).subspan(session_idx * NONCE_BYTE_LEN, NONCE_BYTE_LEN));
+    }
+
+    benchmark::DoNotOptimize(csprngs);
+    benchmark::DoNotOptimize(nonces);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_sessions));
+}
+
+// Squeezes a 16 -bytes nonce from each instance of a batch CSPRNG, holding one instance per session, at once.
+template<size_t num_sessions>
+void
+bench_batch_csprng_nonce_generation(benchmark::State& state)
+{
+  using batch_csprng_t = randomshake::randomshake_batch_t<num_sessions>;
+
+  std::array<uint8_t, num_sessions * batch_csprng_t::seed_byte_len> seeds{};
+  for (size_t session_idx = 0; session_idx < num_sessions; session_idx++) {
+    std::ranges::fill(std::span(seeds).subspan(session_idx * batch_csprng_t::seed_byte_len, batch_csprng_t::seed_byte_len), static_cast<uint8_t>(session_idx));
+  }
+
+  auto csprng = std::make_unique<batch_csprng_t>(seeds);
+
+  constexpr size_t NONCE_BYTE_LEN = 16;
+  std::vector<uint8_t> nonces(num_sessions * NONCE_BYTE_LEN, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(csprng.get());
+    benchmark::DoNotOptimize(nonces);
+
+    csprng->generate_all(nonces);
+
+    benchmark::DoNotOptimize(csprng.get());
+    benchmark::DoNotOptimize(nonces);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_sessions));
+}
+
+template<randomshake::xof_kind_t xof_kind, size_t ratchet_period_block_count = randomshake::default_ratchet_period_block_count<xof_kind>>
 void
 bench_csprng_byte_sequence_squeezing(benchmark::State& state)
 {
   std::array<uint8_t, randomshake::randomshake_t<uint8_t, xof_kind>::seed_byte_len> seed{};
   seed.fill(0xde);
 
-  randomshake::randomshake_t<uint8_t, xof_kind> csprng(seed);
+  randomshake::randomshake_t<uint8_t, xof_kind, ratchet_period_block_count> csprng(seed);
 
   constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 1'024UL * 1'024UL; // 1 MB
   std::vector<uint8_t> rand_byte_seq(RANDOM_OUTPUT_BYTE_LEN, 0);
@@ -57,6 +205,113 @@ bench_csprng_byte_sequence_squeezing(benchmark::State& state)
   state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(rand_byte_seq.size()));
 }
 
+template<randomshake::xof_kind_t xof_kind, size_t num_lanes>
+void
+bench_multilane_csprng_byte_sequence_squeezing(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_multilane_t<uint8_t, xof_kind, num_lanes>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_multilane_t<uint8_t, xof_kind, num_lanes> csprng(seed);
+
+  constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 1'024UL * 1'024UL; // 1 MB
+  std::vector<uint8_t> rand_byte_seq(RANDOM_OUTPUT_BYTE_LEN, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_byte_seq);
+
+    csprng.generate(rand_byte_seq);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_byte_seq);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(rand_byte_seq.size()));
+}
+
+template<randomshake::xof_kind_t xof_kind>
+void
+bench_seekable_csprng_byte_sequence_squeezing(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_seekable_t<uint8_t, xof_kind>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_seekable_t<uint8_t, xof_kind> csprng(seed);
+
+  constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 1'024UL * 1'024UL; // 1 MB
+  std::vector<uint8_t> rand_byte_seq(RANDOM_OUTPUT_BYTE_LEN, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_byte_seq);
+
+    csprng.generate(rand_byte_seq);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_byte_seq);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(rand_byte_seq.size()));
+}
+
+template<randomshake::xof_kind_t xof_kind>
+void
+bench_seekable_csprng_random_access(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_seekable_t<uint8_t, xof_kind>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  const randomshake::randomshake_seekable_t<uint8_t, xof_kind> csprng(seed);
+
+  // Squeezes a 32 -bytes window, far into the output stream, without producing anything preceding it.
+  constexpr uint64_t BYTE_OFFSET = 1'024UL * 1'024UL * 1'024UL * 1'024UL; // 1 TB
+  std::array<uint8_t, 32> rand_window{};
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_window);
+
+    csprng.generate_at(BYTE_OFFSET, rand_window);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_window);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(rand_window.size()));
+}
+
+// Fills a 64MB buffer using `generate_parallel`, with as many threads as passed in benchmark argument.
+template<randomshake::xof_kind_t xof_kind>
+void
+bench_csprng_parallel_byte_sequence_squeezing(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<uint8_t, xof_kind>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint8_t, xof_kind> csprng(seed);
+  const randomshake::std_thread_executor_t executor{ static_cast<size_t>(state.range(0)) };
+
+  constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 64UL * 1'024UL * 1'024UL; // 64 MB
+  std::vector<uint8_t> rand_byte_seq(RANDOM_OUTPUT_BYTE_LEN, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_byte_seq);
+
+    randomshake::generate_parallel(csprng, std::span(rand_byte_seq), executor);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(rand_byte_seq);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(rand_byte_seq.size()));
+}
+
 }
 
 BENCHMARK(bench_csprng_output_generation<uint8_t>)->Name("csprng/generate_u8")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
@@ -64,6 +319,46 @@ BENCHMARK(bench_csprng_output_generation<uint16_t>)->Name("csprng/generate_u16")
 BENCHMARK(bench_csprng_output_generation<uint32_t>)->Name("csprng/generate_u32")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 BENCHMARK(bench_csprng_output_generation<uint64_t>)->Name("csprng/generate_u64")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 
+BENCHMARK(bench_compact_csprng_output_generation<uint8_t>)
+  ->Name("csprng_compact/generate_u8")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_compact_csprng_output_generation<uint64_t>)
+  ->Name("csprng_compact/generate_u64")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_prefetching_csprng_output_generation<uint64_t, randomshake::refill_mode_t::BACKGROUND_THREAD>)
+  ->Name("csprng_prefetching/background_thread/generate_u64")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_prefetching_csprng_output_generation<uint64_t, randomshake::refill_mode_t::MANUAL>)
+  ->Name("csprng_prefetching/manual/generate_u64")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_csprng_batched_output_generation<uint16_t>)
+  ->Name("csprng/generate_u16_array")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_csprng_batched_output_generation<uint32_t>)
+  ->Name("csprng/generate_u32_array")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_csprng_batched_output_generation<uint64_t>)
+  ->Name("csprng/generate_u64_array")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_per_session_csprng_nonce_generation<256>)
+  ->Name("csprng_per_session/256_sessions/generate_16B_nonces")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_batch_csprng_nonce_generation<256>)
+  ->Name("csprng_batch/256_sessions/generate_16B_nonces")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
 BENCHMARK(bench_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::SHAKE256>)
   ->Name("csprng/shake256/generate_byte_seq")
   ->ComputeStatistics("min", compute_min)
@@ -72,3 +367,62 @@ BENCHMARK(bench_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHA
   ->Name("csprng/turboshake256/generate_byte_seq")
   ->ComputeStatistics("min", compute_min)
   ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::SHAKE128>)
+  ->Name("csprng/shake128/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE128>)
+  ->Name("csprng/turboshake128/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256_TREE>)
+  ->Name("csprng/turboshake256_tree/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256, 1>)
+  ->Name("csprng/turboshake256/ratchet_every_1_block/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256, 32>)
+  ->Name("csprng/turboshake256/ratchet_every_32_blocks/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256, 128>)
+  ->Name("csprng/turboshake256/ratchet_every_128_blocks/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_multilane_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256, 4>)
+  ->Name("csprng_x4/turboshake256/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_multilane_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256, 8>)
+  ->Name("csprng_x8/turboshake256/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_seekable_csprng_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256>)
+  ->Name("csprng_seekable/turboshake256/generate_byte_seq")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_seekable_csprng_random_access<randomshake::xof_kind_t::TURBOSHAKE256>)
+  ->Name("csprng_seekable/turboshake256/generate_at")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_csprng_parallel_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256>)
+  ->Name("csprng/turboshake256/generate_parallel")
+  ->RangeMultiplier(2)
+  ->Range(1, static_cast<int64_t>(std::max(std::thread::hardware_concurrency(), 1U)))
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_csprng_parallel_byte_sequence_squeezing<randomshake::xof_kind_t::TURBOSHAKE256_TREE>)
+  ->Name("csprng/turboshake256_tree/generate_parallel")
+  ->RangeMultiplier(2)
+  ->Range(1, static_cast<int64_t>(std::max(std::thread::hardware_concurrency(), 1U)))
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
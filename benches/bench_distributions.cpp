@@ -0,0 +1,501 @@
+#include "bench_utils.hpp"
+#include "randomshake/bernoulli.hpp"
+#include "randomshake/normal.hpp"
+#include "randomshake/randomshake.hpp"
+#include "randomshake/shuffle.hpp"
+#include "randomshake/uniform_int.hpp"
+#include "randomshake/uniform_real.hpp"
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr size_t NUM_SAMPLES = 1'024UL * 64UL;
+
+// Samples uniformly distributed integers, one at a time, using `std::uniform_int_distribution`. Serves as the baseline.
+template<typename T>
+void
+bench_std_uniform_int_distribution(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+  std::uniform_int_distribution<T> dist{ 1, static_cast<T>(state.range(0)) };
+
+  std::vector<T> values(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    std::ranges::generate(values, [&]() { return dist(csprng); });
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Samples uniformly distributed integers, in bulk, using `randomshake::uniform_int_fill`.
+template<typename T>
+void
+bench_uniform_int_fill(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+  const auto hi = static_cast<T>(state.range(0));
+
+  std::vector<T> values(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    randomshake::uniform_int_fill(csprng, std::span(values), 1, hi);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Samples uniformly distributed floating-point values, one at a time, using `std::uniform_real_distribution`. Serves as the baseline.
+template<typename result_type, typename F>
+void
+bench_std_uniform_real_distribution(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<result_type> csprng(seed);
+  std::uniform_real_distribution<F> dist{ -1, 1 };
+
+  std::vector<F> values(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    std::ranges::generate(values, [&]() { return dist(csprng); });
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Samples uniformly distributed floating-point values, in bulk, using `randomshake::uniform_real_fill`.
+template<typename F>
+void
+bench_uniform_real_fill(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<F> values(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    randomshake::uniform_real_fill(csprng, std::span(values), -1, 1);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Samples normally distributed floating-point values, one at a time, using `std::normal_distribution`. Serves as the baseline.
+template<typename F>
+void
+bench_std_normal_distribution(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+  std::normal_distribution<F> dist{ 0, 1 };
+
+  std::vector<F> values(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    std::ranges::generate(values, [&]() { return dist(csprng); });
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Samples normally distributed floating-point values, in bulk, using `randomshake::normal_fill`.
+template<typename F>
+void
+bench_normal_fill(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<F> values(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    randomshake::normal_fill(csprng, std::span(values));
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Samples discrete Gaussian distributed integers, in bulk and in constant-time, using `randomshake::discrete_gaussian_cdt_t`.
+void
+bench_discrete_gaussian_fill(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+  const randomshake::discrete_gaussian_cdt_t sampler(static_cast<double>(state.range(0)) / 10.);
+
+  std::vector<int32_t> values(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    sampler.fill(csprng, std::span(values));
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Shuffles an array of `state.range(0)` -many 32-bit integers, using `std::shuffle`. Serves as the baseline.
+void
+bench_std_shuffle(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+
+  std::vector<uint32_t> values(static_cast<size_t>(state.range(0)), 0);
+  std::iota(values.begin(), values.end(), 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    std::shuffle(values.begin(), values.end(), csprng);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Shuffles an array of `state.range(0)` -many 32-bit integers, using `randomshake::shuffle`.
+void
+bench_shuffle(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+
+  std::vector<uint32_t> values(static_cast<size_t>(state.range(0)), 0);
+  std::iota(values.begin(), values.end(), 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+
+    randomshake::shuffle(csprng, values);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+// Samples `state.range(1)` -many elements, without replacement, from a population of `state.range(0)` -many 32-bit integers.
+void
+bench_sample(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+
+  std::vector<uint32_t> population(static_cast<size_t>(state.range(0)), 0);
+  std::iota(population.begin(), population.end(), 0);
+
+  const auto k = static_cast<size_t>(state.range(1));
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(population);
+
+    auto sampled = randomshake::sample(csprng, population, k);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(sampled);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(k));
+}
+
+// Runs Bernoulli trials, one at a time, using `std::bernoulli_distribution`. Serves as the baseline.
+void
+bench_std_bernoulli_distribution(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+  std::bernoulli_distribution dist{ static_cast<double>(state.range(0)) / 100. };
+
+  std::vector<uint8_t> trials(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(trials);
+
+    std::ranges::generate(trials, [&]() { return static_cast<uint8_t>(dist(csprng)); });
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(trials);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(trials.size()));
+}
+
+// Runs Bernoulli trials, in bulk, using `randomshake::bernoulli_fill`.
+void
+bench_bernoulli_fill(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+  const double p = static_cast<double>(state.range(0)) / 100.;
+
+  std::vector<uint8_t> trials(NUM_SAMPLES, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(trials);
+
+    randomshake::bernoulli_fill(csprng, std::span(trials), p);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(trials);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(trials.size()));
+}
+
+// Samples number of successes in 1'000 trials, one sample at a time, using `std::binomial_distribution`. Serves as the baseline.
+void
+bench_std_binomial_distribution(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+  std::binomial_distribution<uint32_t> dist{ 1'000, static_cast<double>(state.range(0)) / 100. };
+
+  std::vector<uint32_t> samples(NUM_SAMPLES / 64, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(samples);
+
+    std::ranges::generate(samples, [&]() { return dist(csprng); });
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(samples);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(samples.size()));
+}
+
+// Samples number of successes in 1'000 trials, in bulk, using `randomshake::binomial_fill`.
+void
+bench_binomial_fill(benchmark::State& state)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+  const double p = static_cast<double>(state.range(0)) / 100.;
+
+  std::vector<uint32_t> samples(NUM_SAMPLES / 64, 0);
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(samples);
+
+    randomshake::binomial_fill(csprng, std::span(samples), 1'000U, p);
+
+    benchmark::DoNotOptimize(&csprng);
+    benchmark::DoNotOptimize(samples);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(samples.size()));
+}
+}
+
+BENCHMARK(bench_std_uniform_int_distribution<uint32_t>)
+  ->Name("uniform_int/std_distribution/u32")
+  ->Arg(6)
+  ->Arg(1'000'000'007)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_uniform_int_fill<uint32_t>)
+  ->Name("uniform_int/uniform_int_fill/u32")
+  ->Arg(6)
+  ->Arg(1'000'000'007)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_std_uniform_int_distribution<uint64_t>)
+  ->Name("uniform_int/std_distribution/u64")
+  ->Arg(6)
+  ->Arg(1'000'000'007)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_uniform_int_fill<uint64_t>)
+  ->Name("uniform_int/uniform_int_fill/u64")
+  ->Arg(6)
+  ->Arg(1'000'000'007)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_std_uniform_real_distribution<uint8_t, float>)
+  ->Name("uniform_real/std_distribution/u8_csprng/f32")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_std_uniform_real_distribution<uint64_t, float>)
+  ->Name("uniform_real/std_distribution/u64_csprng/f32")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_uniform_real_fill<float>)
+  ->Name("uniform_real/uniform_real_fill/f32")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_std_uniform_real_distribution<uint8_t, double>)
+  ->Name("uniform_real/std_distribution/u8_csprng/f64")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_std_uniform_real_distribution<uint64_t, double>)
+  ->Name("uniform_real/std_distribution/u64_csprng/f64")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_uniform_real_fill<double>)
+  ->Name("uniform_real/uniform_real_fill/f64")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_std_normal_distribution<double>)
+  ->Name("normal/std_distribution/f64")
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_normal_fill<double>)->Name("normal/normal_fill/f64")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+
+// Argument is 10 x sigma of the discrete Gaussian distribution.
+BENCHMARK(bench_discrete_gaussian_fill)
+  ->Name("discrete_gaussian/cdt_fill/i32")
+  ->Arg(32)
+  ->Arg(170)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_std_shuffle)
+  ->Name("shuffle/std_shuffle/u32")
+  ->Arg(1L << 16)
+  ->Arg(1L << 22)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_shuffle)
+  ->Name("shuffle/shuffle/u32")
+  ->Arg(1L << 16)
+  ->Arg(1L << 22)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_sample)
+  ->Name("shuffle/sample/u32")
+  ->Args({ 1L << 22, 1L << 10 })
+  ->Args({ 1L << 22, 1L << 20 })
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+// Argument is 100 x success probability of each trial.
+BENCHMARK(bench_std_bernoulli_distribution)
+  ->Name("bernoulli/std_distribution/u8")
+  ->Arg(50)
+  ->Arg(30)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_bernoulli_fill)
+  ->Name("bernoulli/bernoulli_fill/u8")
+  ->Arg(50)
+  ->Arg(30)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_std_binomial_distribution)
+  ->Name("binomial/std_distribution/u32")
+  ->Arg(50)
+  ->Arg(30)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_binomial_fill)
+  ->Name("binomial/binomial_fill/u32")
+  ->Arg(50)
+  ->Arg(30)
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
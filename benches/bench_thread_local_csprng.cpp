@@ -0,0 +1,73 @@
+#include "bench_utils.hpp"
+#include "randomshake/randomshake.hpp"
+#include "randomshake/thread_local_csprng.hpp"
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 4'096UL; // 4 KB
+
+// Every benchmark thread squeezes from its own, lazily created, thread-local CSPRNG instance.
+void
+bench_thread_local_csprng_generation(benchmark::State& state)
+{
+  std::array<uint8_t, RANDOM_OUTPUT_BYTE_LEN> rand_byte_seq{};
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(rand_byte_seq);
+
+    randomshake::thread_local_csprng().generate(rand_byte_seq);
+
+    benchmark::DoNotOptimize(rand_byte_seq);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(rand_byte_seq.size()));
+}
+
+// All benchmark threads squeeze from a single CSPRNG instance, guarded by a mutex. Serves as the baseline.
+void
+bench_mutex_guarded_csprng_generation(benchmark::State& state)
+{
+  static std::mutex csprng_mutex{};
+  static randomshake::randomshake_t csprng{};
+
+  std::array<uint8_t, RANDOM_OUTPUT_BYTE_LEN> rand_byte_seq{};
+
+  for (auto _itr : state) {
+    benchmark::DoNotOptimize(rand_byte_seq);
+
+    {
+      const std::scoped_lock lock(csprng_mutex);
+      csprng.generate(rand_byte_seq);
+    }
+
+    benchmark::DoNotOptimize(rand_byte_seq);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(rand_byte_seq.size()));
+}
+
+const auto MAX_BENCH_THREADS = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+
+}
+
+BENCHMARK(bench_thread_local_csprng_generation)
+  ->Name("thread_local_csprng/generate_byte_seq")
+  ->ThreadRange(1, MAX_BENCH_THREADS)
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+
+BENCHMARK(bench_mutex_guarded_csprng_generation)
+  ->Name("mutex_guarded_csprng/generate_byte_seq")
+  ->ThreadRange(1, MAX_BENCH_THREADS)
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
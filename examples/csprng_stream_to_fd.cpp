@@ -0,0 +1,68 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/stream_to_fd.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include <unistd.h>
+
+// Writes N random bytes to a file, a block device or, when the output path is "-", standard output, reporting sustained
+// throughput on standard error. Without arguments, it writes 64 MiB of random bytes to /dev/null.
+//
+// Usage: csprng_stream_to_fd [num-bytes] [output-path]
+int
+main(int argc, char** argv)
+{
+  const auto print_usage = [&]() {
+    std::cerr << "Usage: " << argv[0] << " [num-bytes] [output-path]\n"; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  };
+
+  if (argc > 3) {
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  uint64_t num_bytes = 64UL << 20;
+  if (argc >= 2) {
+    // Unlike `std::stoull`, `std::from_chars` doesn't accept a leading '-', which would wrap around to a huge unsigned value.
+    const std::string_view num_bytes_arg(argv[1]);                           // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const char* const arg_end = num_bytes_arg.data() + num_bytes_arg.size(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto [parsed_till, err] = std::from_chars(num_bytes_arg.data(), arg_end, num_bytes);
+
+    if (num_bytes_arg.empty() || (err != std::errc{}) || (parsed_till != arg_end)) {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  const std::string_view output_path = (argc == 3) ? argv[2] : "/dev/null"; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+  int fd = STDOUT_FILENO;
+  if (output_path != "-") {
+    fd = ::open(output_path.data(), O_WRONLY | O_CREAT | O_TRUNC, 0644); // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    if (fd < 0) {
+      std::cerr << "Failed to open output: " << std::generic_category().message(errno) << '\n';
+      return EXIT_FAILURE;
+    }
+  }
+
+  randomshake::randomshake_t csprng;
+  const auto stats = randomshake::stream_to_fd(csprng, fd, num_bytes);
+
+  if (fd != STDOUT_FILENO) {
+    ::close(fd);
+  }
+
+  if (stats.error != 0) {
+    std::cerr << "Failed after writing " << stats.num_bytes_written << " bytes: " << std::generic_category().message(stats.error) << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::cerr << "Wrote " << stats.num_bytes_written << " bytes to " << output_path << " in " << stats.seconds << " s, at " << stats.gigabytes_per_second()
+            << " GB/s\n";
+  return EXIT_SUCCESS;
+}
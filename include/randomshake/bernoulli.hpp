@@ -0,0 +1,313 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace randomshake {
+
+/**
+ * Reads a stream of random bits, from 64-bit words squeezed from `csprng` in bulk, so that samplers can consume exactly as
+ * many bits as they need. Bits of each word are read from the most significant one to the least significant one.
+ *
+ * Words are squeezed lazily, only once a bit of them is peeked, and each squeeze is sized by `expected_num_words`, the number
+ * of words the caller expects to consume, up to a buffer of 2 KiB. Once that estimate is used up, words are squeezed one at a
+ * time. So a reader consumes at most as many words as estimated or actually needed, whichever is larger. Words left unread,
+ * when the reader is destroyed, are zeroized and dropped.
+ */
+template<typename csprng_t>
+  requires(bulk_generator<csprng_t, uint64_t>)
+struct random_bit_reader_t
+{
+private:
+  static constexpr size_t WORD_BUFFER_LEN = 256;
+  static constexpr size_t word_bw = std::numeric_limits<uint64_t>::digits;
+
+  csprng_t& csprng;
+  std::array<uint64_t, WORD_BUFFER_LEN> words{};
+  size_t num_buffered_words = 0;
+  size_t word_idx = 0;
+  size_t num_expected_words_left = 0;
+
+  // Current word, of which first `bit_offset` bits are already consumed, and the word following it, each one squeezed only when needed.
+  uint64_t cur_word = 0;
+  uint64_t next_word = 0;
+  bool has_cur_word = false;
+  bool has_next_word = false;
+  size_t bit_offset = 0;
+
+  forceinline uint64_t fetch_word()
+  {
+    if (word_idx == num_buffered_words) [[unlikely]] {
+      num_buffered_words = std::clamp<size_t>(num_expected_words_left, 1, WORD_BUFFER_LEN);
+      num_expected_words_left -= std::min(num_expected_words_left, num_buffered_words);
+
+      csprng.generate(std::span<uint64_t>(words).first(num_buffered_words));
+      word_idx = 0;
+    }
+
+    return words[word_idx++];
+  }
+
+public:
+  forceinline random_bit_reader_t(csprng_t& generator, const size_t expected_num_words)
+    : csprng(generator)
+    , num_expected_words_left(expected_num_words)
+  {
+  }
+
+  random_bit_reader_t(const random_bit_reader_t&) = delete;
+  random_bit_reader_t(random_bit_reader_t&&) = delete;
+  random_bit_reader_t& operator=(const random_bit_reader_t&) = delete;
+  random_bit_reader_t& operator=(random_bit_reader_t&&) = delete;
+
+  // Zeroize buffered random words, when done.
+  ~random_bit_reader_t()
+  {
+    words.fill(0);
+    cur_word = 0;
+    next_word = 0;
+
+    DoNotOptimize(words);
+    DoNotOptimize(cur_word);
+    DoNotOptimize(next_word);
+  }
+
+  /**
+   * Returns next 64 bits, packed from the most significant bit, without consuming them. Only the first `num_bits` of them are
+   * guaranteed to be unconsumed random bits, the rest may be zeros, so that no word is squeezed before it's really needed.
+   */
+  [[nodiscard]] forceinline uint64_t peek(const size_t num_bits = word_bw)
+  {
+    if (!has_cur_word) {
+      cur_word = fetch_word();
+      has_cur_word = true;
+    }
+    if (bit_offset == 0) {
+      return cur_word;
+    }
+    if (bit_offset + num_bits <= word_bw) {
+      return cur_word << bit_offset;
+    }
+
+    if (!has_next_word) {
+      next_word = fetch_word();
+      has_next_word = true;
+    }
+    return (cur_word << bit_offset) | (next_word >> (word_bw - bit_offset));
+  }
+
+  // Consumes `num_bits` of the bits returned by the last `peek`, which must be <= the number of bits asked from it.
+  forceinline void consume(const size_t num_bits)
+  {
+    bit_offset += num_bits;
+
+    if (bit_offset >= word_bw) {
+      bit_offset -= word_bw;
+      cur_word = next_word;
+      has_cur_word = has_next_word;
+      has_next_word = false;
+    }
+  }
+
+  // Consumes and returns next 64 bits.
+  [[nodiscard]] forceinline uint64_t take_word()
+  {
+    const uint64_t word = peek();
+    consume(word_bw);
+
+    return word;
+  }
+};
+
+namespace bernoulli_internals {
+
+// Success probability p, as a 64-bit fixed-point number P = floor(p * 2^64), with the index of its last set bit, from the top.
+struct fixed_point_probability_t
+{
+  uint64_t bits = 0;
+  size_t last_set_bit_idx = 0;
+  bool is_certain = false;
+
+  forceinline explicit fixed_point_probability_t(const double p)
+  {
+    if (!(p > 0.)) {
+      return;
+    }
+    if (p >= 1.) {
+      is_certain = true;
+      return;
+    }
+
+    bits = static_cast<uint64_t>(std::ldexp(p, std::numeric_limits<uint64_t>::digits));
+    last_set_bit_idx = static_cast<size_t>(std::numeric_limits<uint64_t>::digits - 1 - std::countr_zero(bits));
+  }
+
+  [[nodiscard]] forceinline bool is_impossible() const { return !is_certain && (bits == 0); }
+
+  /**
+   * Upper bound on the mean number of random words consumed by `num_trials` calls to `trial`. Trial reads bit k of U, only if
+   * its first k bits match p, so it consumes 2 - 2^-L bits, on average, where L is the index of the last set bit of p. That's
+   * exactly ceil(num_trials / 64) words, when p = 0.5.
+   */
+  [[nodiscard]] forceinline size_t expected_num_words(const size_t num_trials) const
+  {
+    constexpr size_t word_bw = std::numeric_limits<uint64_t>::digits;
+    const size_t num_extra_bits = num_trials - (num_trials >> last_set_bit_idx);
+
+    return (num_trials + word_bw - 1) / word_bw + (num_extra_bits + word_bw - 1) / word_bw;
+  }
+
+  /**
+   * Estimate of the number of random words consumed by a call to `trial_x64`, which reads one word per bit of p, until all 64
+   * lanes are decided. A lane stays undecided after k words with probability 2^-k, so all 64 of them are decided after ~8 words.
+   */
+  [[nodiscard]] forceinline size_t expected_num_words_x64() const { return std::min<size_t>(last_set_bit_idx + 1, 8); }
+};
+
+/**
+ * Runs a single Bernoulli trial, by lazily comparing the binary expansion of a uniform random number U = 0.b1b2b3..., read from
+ * `reader`, with the binary expansion of p, returning U < p. Bits are consumed only up to the first one differing from p, or
+ * up to the last set bit of p, beyond which U can't be smaller than p. So it consumes at most 2 bits, on average, and exactly
+ * 1 bit, when p = 0.5.
+ */
+template<typename reader_t>
+forceinline bool
+trial(reader_t& reader, const fixed_point_probability_t& prob)
+{
+  // Bits of U beyond the last set bit of p don't affect the comparison, so those needn't be squeezed yet.
+  const uint64_t diff = reader.peek(prob.last_set_bit_idx + 1) ^ prob.bits;
+  const auto first_diff_bit_idx = static_cast<size_t>(std::countl_zero(diff));
+
+  if (first_diff_bit_idx > prob.last_set_bit_idx) {
+    reader.consume(prob.last_set_bit_idx + 1);
+    return false;
+  }
+
+  reader.consume(first_diff_bit_idx + 1);
+  return ((prob.bits >> (std::numeric_limits<uint64_t>::digits - 1 - first_diff_bit_idx)) & 1U) == 1U;
+}
+
+/**
+ * Runs 64 Bernoulli trials side-by-side, one per bit lane, returning a mask of successful ones. Same lazy binary expansion
+ * comparison as `trial`, except that bit k of all 64 uniform random numbers comes from the k-th word, and comparison stops
+ * once all lanes are decided. Consumes a single word, when p = 0.5.
+ */
+template<typename reader_t>
+forceinline uint64_t
+trial_x64(reader_t& reader, const fixed_point_probability_t& prob)
+{
+  uint64_t undecided = std::numeric_limits<uint64_t>::max();
+  uint64_t successes = 0;
+
+  for (size_t bit_idx = 0; (bit_idx <= prob.last_set_bit_idx) && (undecided != 0); bit_idx++) {
+    const uint64_t word = reader.take_word();
+
+    if (((prob.bits >> (std::numeric_limits<uint64_t>::digits - 1 - bit_idx)) & 1U) == 1U) {
+      successes |= undecided & ~word;
+      undecided &= word;
+    } else {
+      undecided &= ~word;
+    }
+  }
+
+  return successes;
+}
+
+}
+
+/**
+ * Fills `output` with outcomes of independent Bernoulli trials, each one succeeding with probability `p`, consuming only as
+ * many random bits as needed. Each trial lazily compares a uniform random number, bit by bit, with the binary expansion of p,
+ * so it consumes exactly 1 bit, when p = 0.5, and at most 2 bits, on average, for any other p. Compare that with
+ * `std::bernoulli_distribution`, which consumes at least one full word per trial.
+ *
+ * Random bits are squeezed as whole 64-bit words, sized to the expected need of this call, and bits left in the last word are
+ * dropped. So a call consumes exactly ceil(n / 64) words, for n trials at p = 0.5. For any other p, it consumes words for
+ * the mean number of bits, rounded up, or a few words more, if trials happen to need more than that. Fill as many trials as
+ * you can in a single call, as each call rounds up to whole words.
+ *
+ * p is rounded down to a multiple of 2^-64, before sampling. p <= 0 and p >= 1 consume no random bits at all.
+ */
+template<typename csprng_t, typename T>
+  requires((std::is_same_v<T, bool> || std::is_same_v<T, uint8_t>) && bulk_generator<csprng_t, uint64_t>)
+forceinline void
+bernoulli_fill(csprng_t& csprng, std::span<T> output, const double p)
+{
+  const bernoulli_internals::fixed_point_probability_t prob(p);
+
+  if (prob.is_certain || prob.is_impossible()) {
+    std::ranges::fill(output, static_cast<T>(prob.is_certain));
+    return;
+  }
+
+  random_bit_reader_t reader(csprng, prob.expected_num_words(output.size()));
+
+  // When p = 0.5, a trial succeeds iff its only bit is 0, so a whole word serves 64 trials, at once.
+  size_t out_offset = 0;
+  if (prob.last_set_bit_idx == 0) {
+    constexpr size_t word_bw = std::numeric_limits<uint64_t>::digits;
+
+    for (; out_offset + word_bw <= output.size(); out_offset += word_bw) {
+      const uint64_t word = ~reader.take_word();
+
+      for (size_t i = 0; i < word_bw; i++) {
+        output[out_offset + i] = static_cast<T>((word >> (word_bw - 1 - i)) & 1U);
+      }
+    }
+  }
+
+  for (; out_offset < output.size(); out_offset++) {
+    output[out_offset] = static_cast<T>(bernoulli_internals::trial(reader, prob));
+  }
+}
+
+/**
+ * Fills `output` with independent samples from the binomial distribution, i.e. the number of successes in `num_trials`
+ * independent Bernoulli trials, each succeeding with probability `p`. Trials run 64 at a time, one per bit lane of a word,
+ * using bit-sliced lazy comparison with the binary expansion of p, and successes are counted with popcount. When p = 0.5,
+ * that's a single word, per 64 trials.
+ *
+ * Takes O(num_trials / 64) time per sample, so it suits moderate `num_trials`. p is rounded down to a multiple of 2^-64.
+ */
+template<typename csprng_t, typename T>
+  requires(std::is_unsigned_v<T> && !std::is_same_v<T, bool> && bulk_generator<csprng_t, uint64_t>)
+forceinline void
+binomial_fill(csprng_t& csprng, std::span<T> output, const T num_trials, const double p)
+{
+  const bernoulli_internals::fixed_point_probability_t prob(p);
+
+  if (prob.is_certain || prob.is_impossible()) {
+    std::ranges::fill(output, prob.is_certain ? num_trials : T{ 0 });
+    return;
+  }
+
+  constexpr size_t word_bw = std::numeric_limits<uint64_t>::digits;
+
+  const auto num_whole_words = static_cast<uint64_t>(num_trials) / word_bw;
+  const auto num_tail_trials = static_cast<size_t>(static_cast<uint64_t>(num_trials) % word_bw);
+  const uint64_t tail_mask = (num_tail_trials == 0) ? 0 : (std::numeric_limits<uint64_t>::max() << (word_bw - num_tail_trials));
+
+  const uint64_t num_x64_trials_per_sample = num_whole_words + ((num_tail_trials == 0) ? 0 : 1);
+  random_bit_reader_t reader(csprng, static_cast<size_t>(output.size() * num_x64_trials_per_sample * prob.expected_num_words_x64()));
+
+  for (auto& sample : output) {
+    uint64_t num_successes = 0;
+
+    for (uint64_t i = 0; i < num_whole_words; i++) {
+      num_successes += static_cast<uint64_t>(std::popcount(bernoulli_internals::trial_x64(reader, prob)));
+    }
+    if (num_tail_trials != 0) {
+      num_successes += static_cast<uint64_t>(std::popcount(bernoulli_internals::trial_x64(reader, prob) & tail_mask));
+    }
+
+    sample = static_cast<T>(num_successes);
+  }
+}
+
+}
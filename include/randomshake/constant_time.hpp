@@ -0,0 +1,225 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include "randomshake/uniform_int.hpp"
+#include "randomshake/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace randomshake {
+
+/**
+ * Constant-time API surface of RandomSHAKE, for use in code whose timing is audited, such as signing.
+ *
+ * Functions in this header take time, execute branches and access memory in a way which depends only on public parameters -
+ * the sizes of their inputs and outputs and, for bounded sampling, the interval - never on the random values they consume or
+ * on the contents of the array being shuffled. They also consume a fixed number of random bytes, so consumption of the CSPRNG
+ * output stream doesn't leak anything either.
+ *
+ * RandomSHAKE CSPRNG itself, i.e. `randomshake_t::operator()` and `randomshake_t::generate`, is constant-time in this sense.
+ * Keccak permutation has no secret dependent branches or memory accesses, but the cost of a single `randomshake_t::operator()`
+ * call is not fixed. It ratchets and squeezes the next period, when the buffer runs out, and stitches the value together through
+ * `generate`, when a preceding `generate` call left fewer bytes in the buffer than a value needs. Both depend only on how many
+ * bytes have been squeezed before, never on the squeezed values. When even that must not show, draw single values with
+ * `randomshake_t::next_ct`, which does the same work on every call, at the cost of squeezing a whole ratchet period each time.
+ *
+ * If you are worried about latency of those periodic ratchets, rather than their timing uniformity, see `randomshake_prefetching_t`.
+ *
+ * Note, `<random>` distributions and `uniform_int_fill` use rejection sampling, whose running time depends on the random values
+ * drawn. Don't use them for sampling secrets, where timing is observable. Timing of this header is verified by a dudect-style
+ * statistical test, in tests/timing.
+ */
+
+// Passes `value` through an empty assembly block, so that the compiler can't reason about it and turn mask arithmetic into a branch.
+forceinline uint64_t
+ct_value_barrier(uint64_t value)
+{
+  DoNotOptimize(value);
+  return value;
+}
+
+// Returns all-ones mask, if `x > y`, otherwise returns all-zeros mask, without branching. Same as GT, in BearSSL.
+forceinline uint64_t
+ct_gt_mask(const uint64_t x, const uint64_t y)
+{
+  const uint64_t z = y - x;
+  const uint64_t gt_bit = (z ^ ((x ^ y) & (x ^ z))) >> (std::numeric_limits<uint64_t>::digits - 1);
+
+  return uint64_t{ 0 } - ct_value_barrier(gt_bit);
+}
+
+// Swaps `a` and `b`, if `mask` is all-ones, leaves them as-is, if it is all-zeros, touching every byte of both in either case.
+template<typename T>
+  requires(std::is_trivially_copyable_v<T>)
+forceinline void
+ct_conditional_swap(const uint64_t mask, T& a, T& b)
+{
+  std::array<uint8_t, sizeof(T)> a_bytes{};
+  std::array<uint8_t, sizeof(T)> b_bytes{};
+
+  std::memcpy(a_bytes.data(), &a, sizeof(T));
+  std::memcpy(b_bytes.data(), &b, sizeof(T));
+
+  const auto byte_mask = static_cast<uint8_t>(mask);
+  for (size_t i = 0; i < sizeof(T); i++) {
+    const auto diff = static_cast<uint8_t>((a_bytes[i] ^ b_bytes[i]) & byte_mask);
+
+    a_bytes[i] ^= diff;
+    b_bytes[i] ^= diff;
+  }
+
+  std::memcpy(&a, a_bytes.data(), sizeof(T));
+  std::memcpy(&b, b_bytes.data(), sizeof(T));
+}
+
+/**
+ * Fills `output` with integers, sampled uniformly at random from the closed interval [lo, hi], in constant-time. Expects lo <= hi.
+ *
+ * Each output consumes exactly two 64-bit random words, read as a 128-bit integer W, which is mapped to lo + floor((W * s) / 2^128),
+ * where s = hi - lo + 1. There is no rejection, so the result is biased, but its statistical distance from uniform is at most
+ * s / 2^128 <= 2^-64, which is negligible.
+ */
+template<typename csprng_t, std::integral T>
+  requires(!std::is_same_v<T, bool> && bulk_generator<csprng_t, uint64_t>)
+forceinline void
+uniform_int_ct_fill(csprng_t& csprng, std::span<T> output, const std::type_identity_t<T> lo, const std::type_identity_t<T> hi)
+{
+  using uint_t = std::make_unsigned_t<T>;
+
+  constexpr size_t CHUNK_LEN = 128;
+  constexpr auto word_bw = std::numeric_limits<uint64_t>::digits;
+
+  // Width of the interval, less one. Computed in unsigned arithmetic, so that it is well-defined for signed types too.
+  const auto span_len_minus_one = static_cast<uint64_t>(static_cast<uint_t>(static_cast<uint_t>(hi) - static_cast<uint_t>(lo)));
+  const auto offset_from_lo = [lo](const uint64_t val) { return static_cast<T>(static_cast<uint_t>(static_cast<uint_t>(lo) + static_cast<uint_t>(val))); };
+
+  // Interval covers whole 64-bit range, in which case, the high word is the result. Width of the interval is public.
+  const bool is_full_range = span_len_minus_one == std::numeric_limits<uint64_t>::max();
+  const uint64_t span_len = span_len_minus_one + 1;
+
+  std::array<uint64_t, 2 * CHUNK_LEN> words{};
+  auto words_span = std::span(words);
+
+  for (size_t out_offset = 0; out_offset < output.size(); out_offset += CHUNK_LEN) {
+    const size_t chunk_len = std::min(CHUNK_LEN, output.size() - out_offset);
+    auto chunk = words_span.first(2 * chunk_len);
+    auto out_chunk = output.subspan(out_offset, chunk_len);
+
+    csprng.generate(chunk);
+
+    for (size_t i = 0; i < chunk_len; i++) {
+      const uint64_t w_hi = chunk[2 * i];
+      const uint64_t w_lo = chunk[2 * i + 1];
+
+      if (is_full_range) {
+        out_chunk[i] = offset_from_lo(w_hi);
+        continue;
+      }
+
+      // floor((W * s) / 2^128) = hi(w_hi * s) + carry out of lo(w_hi * s) + hi(w_lo * s).
+      const auto [hi_prod_hi, hi_prod_lo] = widening_mul(w_hi, span_len);
+      const auto [lo_prod_hi, lo_prod_lo] = widening_mul(w_lo, span_len);
+      static_cast<void>(lo_prod_lo);
+
+      const uint64_t sum = hi_prod_lo + lo_prod_hi;
+      const uint64_t carry = ((hi_prod_lo & lo_prod_hi) | ((hi_prod_lo | lo_prod_hi) & ~sum)) >> (word_bw - 1);
+
+      out_chunk[i] = offset_from_lo(hi_prod_hi + carry);
+    }
+  }
+
+  std::ranges::fill(words, 0);
+  DoNotOptimize(words);
+}
+
+// Samples a single integer uniformly at random from the closed interval [lo, hi], in constant-time. See `uniform_int_ct_fill`.
+template<typename csprng_t, std::integral T>
+  requires(!std::is_same_v<T, bool> && bulk_generator<csprng_t, uint64_t>)
+[[nodiscard]] forceinline T
+uniform_int_ct(csprng_t& csprng, const T lo, const std::type_identity_t<T> hi)
+{
+  std::array<T, 1> value{};
+  uniform_int_ct_fill(csprng, std::span<T>(value), lo, hi);
+
+  return value[0];
+}
+
+/**
+ * Shuffles `values` in constant-time, by attaching a random 64-bit key to each element and sorting them by key with a sorting
+ * network, which performs the same sequence of compare-and-swaps, for any content. Compare-and-swaps are branch-free and touch
+ * both elements. Takes O(n log^2 n) time, consuming exactly n 64-bit random words.
+ *
+ * Sorting network is not stable, so ties between equal keys resolve in a fixed order, set by the network, not by the keys. As
+ * any two keys collide with probability 2^-64, it biases the resulting permutation by at most n^2 / 2^65. Sorting network is
+ * the one from D. J. Bernstein's djbsort, which handles any n, not just powers of 2. See https://sorting.cr.yp.to.
+ */
+template<typename csprng_t, typename T>
+  requires(std::is_trivially_copyable_v<T> && bulk_generator<csprng_t, uint64_t>)
+forceinline void
+shuffle_ct(csprng_t& csprng, std::span<T> values)
+{
+  struct keyed_value_t
+  {
+    uint64_t key;
+    T value;
+  };
+
+  const size_t n = values.size();
+  if (n < 2) {
+    return;
+  }
+
+  std::vector<uint64_t> keys(n, 0);
+  csprng.generate(std::span(keys));
+
+  // Entries are built from `values`, not value-initialized first, so that `T` needn't be default constructible.
+  std::vector<keyed_value_t> entries{};
+  entries.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    entries.push_back({ keys[i], values[i] });
+  }
+
+  const auto compare_and_swap = [](keyed_value_t& a, keyed_value_t& b) { ct_conditional_swap(ct_gt_mask(a.key, b.key), a, b); };
+
+  size_t top = 1;
+  while (top < n - top) {
+    top += top;
+  }
+
+  for (size_t p = top; p > 0; p >>= 1) {
+    for (size_t i = 0; i < n - p; i++) {
+      if ((i & p) == 0) {
+        compare_and_swap(entries[i], entries[i + p]);
+      }
+    }
+
+    size_t i = 0;
+    for (size_t q = top; q > p; q >>= 1) {
+      for (; i < n - q; i++) {
+        if ((i & p) == 0) {
+          keyed_value_t a = entries[i + p];
+          for (size_t r = q; r > p; r >>= 1) {
+            compare_and_swap(a, entries[i + r]);
+          }
+          entries[i + p] = a;
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    values[i] = entries[i].value;
+  }
+
+  // Secret sort keys are wiped from heap buffers, right before those are freed.
+  zeroize_memory(std::span(keys));
+  zeroize_memory(std::span(entries));
+}
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include "randomshake/utils.hpp"
+#include "sha3/internals/force_inline.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <span>
+
+#if defined(__linux__) && __has_include(<sys/random.h>)
+#include <cerrno>
+#include <sys/random.h>
+#define RANDOMSHAKE_HAS_GETRANDOM 1
+#define RANDOMSHAKE_HAS_GETENTROPY 0
+#elif (defined(__APPLE__) && __has_include(<sys/random.h>)) || defined(__OpenBSD__) || defined(__FreeBSD__) || defined(__NetBSD__)
+#include <sys/random.h>
+#include <unistd.h>
+#define RANDOMSHAKE_HAS_GETRANDOM 0
+#define RANDOMSHAKE_HAS_GETENTROPY 1
+#else
+#define RANDOMSHAKE_HAS_GETRANDOM 0
+#define RANDOMSHAKE_HAS_GETENTROPY 0
+#endif
+
+#if defined(__RDSEED__) && (defined(__x86_64__) || defined(_M_X64))
+#include <immintrin.h>
+#define RANDOMSHAKE_HAS_HARDWARE_ENTROPY 1
+#elif defined(__ARM_FEATURE_RNG) && defined(__aarch64__)
+#include <arm_acle.h>
+#define RANDOMSHAKE_HAS_HARDWARE_ENTROPY 1
+#else
+#define RANDOMSHAKE_HAS_HARDWARE_ENTROPY 0
+#endif
+
+namespace randomshake {
+
+/**
+ * An entropy source is anything which can fill a span of bytes with non-deterministic bytes. It is used for sampling seed of
+ * non-deterministically initialized CSPRNG instances. It must always fill the whole span, falling back to a slower source,
+ * if needed, as there is no way to report failure.
+ */
+template<typename source_t>
+concept entropy_source = requires(source_t& source, std::span<uint8_t> output) { source.fill(output); };
+
+// Signature of the function, which gets invoked when an entropy source suspects that it is not non-deterministic.
+using entropy_warning_handler_t = void (*)(const char* message);
+
+// Default entropy warning handler, which prints the warning to standard output.
+inline void
+print_entropy_warning(const char* message)
+{
+  std::cout << "[RANDOMSHAKE WARNING] " << message << '\n';
+}
+
+/**
+ * Invoked with a warning message, when an entropy source suspects that it is not non-deterministic. Store `nullptr` for
+ * ignoring such warnings, or your own handler for logging them, without ever touching standard output.
+ */
+inline std::atomic<entropy_warning_handler_t> entropy_warning_handler{ &print_entropy_warning };
+
+// Entropy source backed by `std::random_device`, squeezing one `std::random_device::result_type` at a time.
+// Before you use it, I strongly advise you to read https://en.cppreference.com/w/cpp/numeric/random/random_device.
+struct random_device_entropy_source_t
+{
+  forceinline void fill(std::span<uint8_t> output) const
+  {
+    std::random_device rdev{};
+    if (rdev.entropy() == 0.) {
+      if (const auto handler = entropy_warning_handler.load(std::memory_order_relaxed); handler != nullptr) {
+        handler("Non-deterministic seed generator has zero entropy ! "
+                "Read https://en.cppreference.com/w/cpp/numeric/random/random_device/entropy for more insight.");
+      }
+    }
+
+    constexpr size_t step_by = sizeof(std::random_device::result_type);
+    size_t out_offset = 0;
+    while (out_offset < output.size()) {
+      const auto val = rdev();
+      const size_t copyable_num_bytes = std::min(step_by, output.size() - out_offset);
+
+      std::memcpy(output.subspan(out_offset, copyable_num_bytes).data(), &val, copyable_num_bytes);
+      out_offset += copyable_num_bytes;
+    }
+  }
+};
+
+/**
+ * Entropy source backed by the operating system's CSPRNG, via `getrandom` on Linux and `getentropy` on macOS and BSDs.
+ * Fills a whole seed with a single system call, without opening any file. Falls back to `std::random_device`, on other
+ * platforms, or if the system call is not available at runtime. This is the default entropy source.
+ */
+struct os_entropy_source_t
+{
+  forceinline void fill(std::span<uint8_t> output) const
+  {
+    size_t out_offset = 0;
+
+#if RANDOMSHAKE_HAS_GETRANDOM
+    while (out_offset < output.size()) {
+      const auto remaining = output.subspan(out_offset);
+      const auto num_bytes = ::getrandom(remaining.data(), remaining.size(), 0);
+      if (num_bytes < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+
+      out_offset += static_cast<size_t>(num_bytes);
+    }
+#elif RANDOMSHAKE_HAS_GETENTROPY
+    // `getentropy` refuses requests longer than 256 -bytes.
+    constexpr size_t max_request_byte_len = 256;
+    while (out_offset < output.size()) {
+      const auto chunk = output.subspan(out_offset, std::min(max_request_byte_len, output.size() - out_offset));
+      if (::getentropy(chunk.data(), chunk.size()) != 0) {
+        break;
+      }
+
+      out_offset += chunk.size();
+    }
+#endif
+
+    if (out_offset < output.size()) {
+      random_device_entropy_source_t{}.fill(output.subspan(out_offset));
+    }
+  }
+};
+
+/**
+ * Wraps another entropy source, XOR-ing its output with output of the CPU's hardware entropy source - RDSEED on x86_64
+ * (compile with `-mrdseed`) and RNDR on AArch64 (compile with `-march=armv8.5-a+rng`). As long as either of them is
+ * non-deterministic, so is the result. Hardware entropy source may transiently run dry, in which case a few retries are made,
+ * before leaving that word as-is. When the target doesn't support any of these instructions, this is same as the wrapped source.
+ */
+template<typename base_source_t = os_entropy_source_t>
+  requires(entropy_source<base_source_t>)
+struct hardware_mixed_entropy_source_t
+{
+  base_source_t base_source{};
+
+  // Returns true, if the hardware entropy source is supported by the compilation target.
+  static constexpr bool has_hardware_entropy() { return RANDOMSHAKE_HAS_HARDWARE_ENTROPY != 0; }
+
+  forceinline void fill(std::span<uint8_t> output)
+  {
+    base_source.fill(output);
+
+#if RANDOMSHAKE_HAS_HARDWARE_ENTROPY
+    constexpr size_t max_num_retries = 16;
+
+    for (size_t out_offset = 0; out_offset < output.size(); out_offset += sizeof(uint64_t)) {
+      unsigned long long hw_word = 0; // NOLINT(google-runtime-int)
+      bool is_hw_word_ready = false;
+
+      for (size_t retry = 0; (retry < max_num_retries) && !is_hw_word_ready; retry++) {
+#if defined(__RDSEED__)
+        is_hw_word_ready = _rdseed64_step(&hw_word) == 1;
+#else
+        uint64_t rndr_word = 0;
+        is_hw_word_ready = __rndr(&rndr_word) == 0;
+        hw_word = rndr_word;
+
+        rndr_word = 0;
+        DoNotOptimize(rndr_word);
+#endif
+      }
+
+      std::array<uint8_t, sizeof(uint64_t)> hw_bytes{};
+      std::memcpy(hw_bytes.data(), &hw_word, hw_bytes.size());
+
+      const auto out_chunk = output.subspan(out_offset, std::min(hw_bytes.size(), output.size() - out_offset));
+      std::ranges::transform(out_chunk, hw_bytes, out_chunk.begin(), [](const uint8_t a, const uint8_t b) { return static_cast<uint8_t>(a ^ b); });
+
+      hw_word = 0;
+      hw_bytes.fill(0);
+
+      DoNotOptimize(hw_word);
+      DoNotOptimize(hw_bytes);
+    }
+#endif
+  }
+};
+
+// Entropy source used by non-deterministically initialized CSPRNG instances, unless asked to use another one.
+using default_entropy_source_t = os_entropy_source_t;
+
+}
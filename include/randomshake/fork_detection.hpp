@@ -0,0 +1,39 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include <atomic>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define RANDOMSHAKE_HAS_FORK_DETECTION 1
+#else
+#define RANDOMSHAKE_HAS_FORK_DETECTION 0
+#endif
+
+namespace randomshake {
+
+// Number of `fork()` calls observed in the lineage of the current process, since the fork handler got registered.
+inline std::atomic<uint64_t> fork_generation_counter{ 0 };
+
+/**
+ * Returns the fork generation of the current process, which is incremented in the child process, every time `fork()` is called.
+ *
+ * Any CSPRNG instance, which remembers the fork generation at which it was last seeded, can detect that it now lives in a
+ * forked child process (and holds the same state as its parent) by comparing it with the current fork generation.
+ * On first call, a `pthread_atfork` child handler is registered, so make sure to call this function once, before `fork()`-ing,
+ * if you intend to use fork detection. On platforms without `pthread_atfork`, fork generation is always 0.
+ */
+forceinline uint64_t
+fork_generation()
+{
+#if RANDOMSHAKE_HAS_FORK_DETECTION
+  static const bool registered = []() {
+    return pthread_atfork(nullptr, nullptr, []() { fork_generation_counter.fetch_add(1, std::memory_order_relaxed); }) == 0;
+  }();
+  static_cast<void>(registered);
+#endif
+
+  return fork_generation_counter.load(std::memory_order_relaxed);
+}
+
+}
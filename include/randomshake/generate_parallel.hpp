@@ -0,0 +1,124 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace randomshake {
+
+// Domain separation label, absorbed first, into every child XOF instance producing a chunk of `generate_parallel` output.
+inline constexpr auto GENERATE_PARALLEL_DOMAIN = make_domain_label("RandomSHAKE/generate_parallel");
+
+// Default byte length of chunks, into which `generate_parallel` partitions its output. Each chunk is filled by a single task.
+inline constexpr size_t GENERATE_PARALLEL_DEFAULT_CHUNK_BYTE_LEN = 1'024UL * 1'024UL; // = 1MB
+
+/**
+ * An executor is anything which can be called with a task count `n` and a task, invoking the task exactly once, for every
+ * index in [0, n), possibly concurrently, and returning only after all of them are done. This lets you plug in your own
+ * thread pool, OpenMP or TBB, by wrapping their parallel-for in a lambda.
+ */
+template<typename executor_t>
+concept parallel_executor = requires(executor_t& executor, const size_t num_tasks, const std::function<void(size_t)>& task) { executor(num_tasks, task); };
+
+/**
+ * Default executor, which spawns up to `num_threads - 1` short-lived threads, while the calling thread also takes part.
+ * Threads pick up tasks in index order, from a shared atomic counter, so uneven progress doesn't leave any core idle.
+ */
+struct std_thread_executor_t
+{
+  size_t num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  void operator()(const size_t num_tasks, const std::function<void(size_t)>& task) const
+  {
+    std::atomic<size_t> next_task_idx{ 0 };
+    const auto worker = [&]() {
+      for (size_t task_idx = next_task_idx.fetch_add(1, std::memory_order_relaxed); task_idx < num_tasks;
+           task_idx = next_task_idx.fetch_add(1, std::memory_order_relaxed)) {
+        task(task_idx);
+      }
+    };
+
+    // The calling thread is a worker too. At least it must be, even when asked for zero threads.
+    const size_t num_spawned_threads = std::min(std::max<size_t>(num_threads, 1), num_tasks) - std::min<size_t>(num_tasks, 1);
+
+    std::vector<std::jthread> threads{};
+    threads.reserve(num_spawned_threads);
+    for (size_t i = 0; i < num_spawned_threads; i++) {
+      threads.emplace_back(worker);
+    }
+
+    worker();
+  }
+};
+
+/**
+ * Fills `output` with pseudo-random bytes, using all cores made available by `executor`.
+ *
+ * First `seed_byte_len` -bytes are squeezed from `csprng` as a child key, advancing its output stream. Then `output` is
+ * partitioned into chunks of `chunk_byte_len` -bytes (last one may be shorter) and chunk i is filled by squeezing a child XOF
+ * instance, of the same kind as `csprng`, after absorbing
+ *
+ * DOMAIN || CHILD_KEY || LE64(i)
+ *
+ * As chunks are independent of each other, they are filled concurrently. Output depends only on the state of `csprng` and
+ * `chunk_byte_len`, not on the executor or the number of threads, so it is reproducible for a deterministically seeded
+ * `csprng`. Note, this output is different from what `csprng.generate(output)` would have produced. Child key and child
+ * XOF states are zeroized, after use.
+ */
+template<typename UIntType, xof_kind_t xof_kind, size_t ratchet_period_block_count, typename executor_t = std_thread_executor_t>
+  requires(parallel_executor<executor_t>)
+forceinline void
+generate_parallel(randomshake_t<UIntType, xof_kind, ratchet_period_block_count>& csprng,
+                  std::span<uint8_t> output,
+                  executor_t&& executor = {},
+                  const size_t chunk_byte_len = GENERATE_PARALLEL_DEFAULT_CHUNK_BYTE_LEN)
+{
+  using xof_t = xof_selector_t<xof_kind>::type;
+
+  if (output.empty() || (chunk_byte_len == 0)) {
+    return;
+  }
+
+  std::array<uint8_t, xof_selector_t<xof_kind>::seed_byte_len> child_key{};
+  csprng.generate(child_key);
+
+  // Child key is absorbed once, so that each task only needs to copy the XOF state, absorb the chunk index and squeeze.
+  xof_t keyed_state{};
+  keyed_state.reset();
+  keyed_state.absorb(GENERATE_PARALLEL_DOMAIN);
+  keyed_state.absorb(child_key);
+
+  child_key.fill(0);
+  DoNotOptimize(child_key);
+
+  const size_t num_chunks = (output.size() + chunk_byte_len - 1) / chunk_byte_len;
+
+  std::forward<executor_t>(executor)(num_chunks, [&](const size_t chunk_idx) {
+    const auto chunk_idx_le64 = static_cast<uint64_t>(chunk_idx);
+    std::array<uint8_t, sizeof(chunk_idx_le64)> chunk_idx_bytes{};
+    std::memcpy(chunk_idx_bytes.data(), &chunk_idx_le64, sizeof(chunk_idx_le64));
+
+    const size_t chunk_offset = chunk_idx * chunk_byte_len;
+
+    xof_t child_state = keyed_state;
+    child_state.absorb(chunk_idx_bytes);
+    child_state.finalize();
+    child_state.squeeze(output.subspan(chunk_offset, std::min(chunk_byte_len, output.size() - chunk_offset)));
+
+    child_state.reset();
+    DoNotOptimize(child_state);
+  });
+
+  keyed_state.reset();
+  DoNotOptimize(keyed_state);
+}
+
+}
@@ -0,0 +1,479 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include "randomshake/utils.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace randomshake {
+
+// Number of lanes in Keccak-p[1600] permutation state, each of 64 -bits.
+inline constexpr size_t KECCAK_LANE_CNT = 25;
+
+// Round constants of Keccak-p[1600] permutation. A permutation of `n` rounds applies the last `n` of them.
+inline constexpr std::array<uint64_t, 24> KECCAK_ROUND_CONSTANTS{
+  0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+  0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+  0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+  0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+// Rotation offsets of ρ step, for lane (x, y), found at index x + 5 * y.
+inline constexpr std::array<uint32_t, KECCAK_LANE_CNT> KECCAK_RHO_OFFSETS{
+  0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14,
+};
+
+// Destination index of lane (x, y), found at index x + 5 * y, after π step, which moves it to (y, 2x + 3y).
+inline constexpr std::array<size_t, KECCAK_LANE_CNT> KECCAK_PI_DESTINATIONS = []() {
+  std::array<size_t, KECCAK_LANE_CNT> destinations{};
+  for (size_t y = 0; y < 5; y++) {
+    for (size_t x = 0; x < 5; x++) {
+      destinations[x + 5 * y] = y + 5 * ((2 * x + 3 * y) % 5);
+    }
+  }
+
+  return destinations;
+}();
+
+/**
+ * Keccak-p[1600] permutation states of `num_states`-many independent sponges, stored lane-major, so that lane l of state s is
+ * found at `lanes[l][s]`. Same lane of consecutive states sits in consecutive words, ready to be loaded into a vector register.
+ */
+template<size_t num_states>
+using keccak_lanes_t = std::array<std::array<uint64_t, num_states>, KECCAK_LANE_CNT>;
+
+/**
+ * A vector of `width`-many 64 -bit words, which the compiler maps to a SIMD register, or splits into scalar words, if none fits.
+ * Spelled out for each width, as the vector size attribute doesn't survive being dependent on a template parameter.
+ */
+template<size_t width>
+struct keccak_vec_selector_t
+{};
+
+template<>
+struct keccak_vec_selector_t<1>
+{
+  using type = uint64_t;
+};
+
+template<>
+struct keccak_vec_selector_t<2>
+{
+  using type = uint64_t __attribute__((vector_size(2 * sizeof(uint64_t))));
+};
+
+template<>
+struct keccak_vec_selector_t<4>
+{
+  using type = uint64_t __attribute__((vector_size(4 * sizeof(uint64_t))));
+};
+
+template<>
+struct keccak_vec_selector_t<8>
+{
+  using type = uint64_t __attribute__((vector_size(8 * sizeof(uint64_t))));
+};
+
+template<size_t width>
+using keccak_vec_t = keccak_vec_selector_t<width>::type;
+
+/**
+ * Applies last `num_rounds` rounds of Keccak-p[1600] permutation on states [state_offset, state_offset + width), side-by-side,
+ * each of them living in its own word of the vector registers. It's a plain round function, written on vectors of words.
+ */
+template<size_t width, size_t num_rounds, size_t num_states>
+forceinline void
+keccak_p1600_interleaved(keccak_lanes_t<num_states>& lanes, const size_t state_offset)
+{
+  using vec_t = keccak_vec_t<width>;
+
+  std::array<vec_t, KECCAK_LANE_CNT> state{};
+#pragma GCC unroll 25
+  for (size_t lane_idx = 0; lane_idx < KECCAK_LANE_CNT; lane_idx++) {
+    std::memcpy(&state[lane_idx], &lanes[lane_idx][state_offset], sizeof(vec_t));
+  }
+
+  // Fully unrolled, so that all indices become compile-time constants and the state lives in registers, not on stack.
+#pragma GCC unroll 24
+  for (size_t round_idx = KECCAK_ROUND_CONSTANTS.size() - num_rounds; round_idx < KECCAK_ROUND_CONSTANTS.size(); round_idx++) {
+    // θ step
+    std::array<vec_t, 5> parity{};
+#pragma GCC unroll 5
+    for (size_t x = 0; x < 5; x++) {
+      parity[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+    }
+
+#pragma GCC unroll 5
+    for (size_t x = 0; x < 5; x++) {
+      const vec_t next = parity[(x + 1) % 5];
+      const vec_t diff = parity[(x + 4) % 5] ^ ((next << 1) | (next >> 63));
+
+#pragma GCC unroll 5
+      for (size_t y = 0; y < 5; y++) {
+        state[x + 5 * y] ^= diff;
+      }
+    }
+
+    // ρ and π steps
+    std::array<vec_t, KECCAK_LANE_CNT> permuted{};
+#pragma GCC unroll 25
+    for (size_t lane_idx = 0; lane_idx < KECCAK_LANE_CNT; lane_idx++) {
+      const uint32_t offset = KECCAK_RHO_OFFSETS[lane_idx];
+      permuted[KECCAK_PI_DESTINATIONS[lane_idx]] = (state[lane_idx] << offset) | (state[lane_idx] >> ((64 - offset) % 64));
+    }
+
+    // χ step
+#pragma GCC unroll 5
+    for (size_t y = 0; y < 5; y++) {
+#pragma GCC unroll 5
+      for (size_t x = 0; x < 5; x++) {
+        state[x + 5 * y] = permuted[x + 5 * y] ^ (~permuted[(x + 1) % 5 + 5 * y] & permuted[(x + 2) % 5 + 5 * y]);
+      }
+    }
+
+    // ι step
+    state[0] ^= KECCAK_ROUND_CONSTANTS[round_idx];
+  }
+
+#pragma GCC unroll 25
+  for (size_t lane_idx = 0; lane_idx < KECCAK_LANE_CNT; lane_idx++) {
+    std::memcpy(&lanes[lane_idx][state_offset], &state[lane_idx], sizeof(vec_t));
+  }
+}
+
+/**
+ * Permutes states, starting at `state_offset`, `width`-many at a time. Remaining states, fewer than `width`, are permuted using
+ * narrower vectors, down to a single word, which is the scalar fallback.
+ */
+template<size_t width, size_t num_rounds, size_t num_states>
+forceinline void
+keccak_p1600_interleaved_from(keccak_lanes_t<num_states>& lanes, size_t state_offset)
+{
+  for (; state_offset + width <= num_states; state_offset += width) {
+    keccak_p1600_interleaved<width, num_rounds>(lanes, state_offset);
+  }
+
+  if constexpr (width > 1) {
+    keccak_p1600_interleaved_from<width / 2, num_rounds>(lanes, state_offset);
+  }
+}
+
+// Permutes all states, two at a time, on 128 -bit vectors. Every 64 -bit x86 and ARM core has them, as SSE2 or NEON registers.
+template<size_t num_rounds, size_t num_states>
+void
+keccak_p1600_multistate_vec128(keccak_lanes_t<num_states>& lanes)
+{
+  keccak_p1600_interleaved_from<2, num_rounds>(lanes, 0);
+}
+
+#if defined(__x86_64__)
+// Permutes all states, four at a time, on AVX2 registers.
+template<size_t num_rounds, size_t num_states>
+[[gnu::target("avx2")]] void
+keccak_p1600_multistate_avx2(keccak_lanes_t<num_states>& lanes)
+{
+  keccak_p1600_interleaved_from<4, num_rounds>(lanes, 0);
+}
+
+// Permutes all states, eight at a time, on AVX-512 registers.
+template<size_t num_rounds, size_t num_states>
+[[gnu::target("avx512f")]] void
+keccak_p1600_multistate_avx512(keccak_lanes_t<num_states>& lanes)
+{
+  keccak_p1600_interleaved_from<8, num_rounds>(lanes, 0);
+}
+#endif
+
+// Widest SIMD registers, which the interleaved Keccak-p[1600] permutation can run on.
+enum class keccak_simd_kind_t : uint8_t
+{
+  VEC128, // SSE2 or NEON, or scalar words, on targets having neither.
+  AVX2,
+  AVX512,
+};
+
+// Detects, once, at run-time, the widest SIMD registers supported by the CPU.
+inline keccak_simd_kind_t
+keccak_simd_kind()
+{
+  static const keccak_simd_kind_t simd_kind = []() {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx512f")) {
+      return keccak_simd_kind_t::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return keccak_simd_kind_t::AVX2;
+    }
+#endif
+    return keccak_simd_kind_t::VEC128;
+  }();
+
+  return simd_kind;
+}
+
+/**
+ * Applies last `num_rounds` rounds of Keccak-p[1600] permutation on a single state. It's the scalar reference, which is used
+ * when evaluated at compile-time.
+ */
+template<size_t num_rounds>
+constexpr void
+keccak_p1600(std::array<uint64_t, KECCAK_LANE_CNT>& state)
+{
+  constexpr auto rotl = [](const uint64_t word, const uint32_t offset) { return (word << offset) | (word >> ((64 - offset) % 64)); };
+
+  for (size_t round_idx = KECCAK_ROUND_CONSTANTS.size() - num_rounds; round_idx < KECCAK_ROUND_CONSTANTS.size(); round_idx++) {
+    std::array<uint64_t, 5> parity{};
+    for (size_t x = 0; x < 5; x++) {
+      parity[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+    }
+
+    for (size_t x = 0; x < 5; x++) {
+      const uint64_t diff = parity[(x + 4) % 5] ^ rotl(parity[(x + 1) % 5], 1);
+      for (size_t y = 0; y < 5; y++) {
+        state[x + 5 * y] ^= diff;
+      }
+    }
+
+    std::array<uint64_t, KECCAK_LANE_CNT> permuted{};
+    for (size_t lane_idx = 0; lane_idx < KECCAK_LANE_CNT; lane_idx++) {
+      permuted[KECCAK_PI_DESTINATIONS[lane_idx]] = rotl(state[lane_idx], KECCAK_RHO_OFFSETS[lane_idx]);
+    }
+
+    for (size_t y = 0; y < 5; y++) {
+      for (size_t x = 0; x < 5; x++) {
+        state[x + 5 * y] = permuted[x + 5 * y] ^ (~permuted[(x + 1) % 5 + 5 * y] & permuted[(x + 2) % 5 + 5 * y]);
+      }
+    }
+
+    state[0] ^= KECCAK_ROUND_CONSTANTS[round_idx];
+  }
+}
+
+/**
+ * Applies last `num_rounds` rounds of Keccak-p[1600] permutation on all `num_states`-many states, interleaved in SIMD registers.
+ * Picks the widest registers supported by the CPU, at run-time, so that a single binary runs 8 states side-by-side on AVX-512,
+ * 4 on AVX2 and 2 elsewhere. At compile-time, states are permuted one by one, using the scalar reference.
+ */
+template<size_t num_rounds, size_t num_states>
+forceinline constexpr void
+keccak_p1600_multistate(keccak_lanes_t<num_states>& lanes)
+{
+  if (std::is_constant_evaluated()) {
+    for (size_t state_idx = 0; state_idx < num_states; state_idx++) {
+      std::array<uint64_t, KECCAK_LANE_CNT> state{};
+      for (size_t lane_idx = 0; lane_idx < KECCAK_LANE_CNT; lane_idx++) {
+        state[lane_idx] = lanes[lane_idx][state_idx];
+      }
+
+      keccak_p1600<num_rounds>(state);
+
+      for (size_t lane_idx = 0; lane_idx < KECCAK_LANE_CNT; lane_idx++) {
+        lanes[lane_idx][state_idx] = state[lane_idx];
+      }
+    }
+
+    return;
+  }
+
+  switch (keccak_simd_kind()) {
+#if defined(__x86_64__)
+    case keccak_simd_kind_t::AVX512:
+      keccak_p1600_multistate_avx512<num_rounds>(lanes);
+      break;
+    case keccak_simd_kind_t::AVX2:
+      keccak_p1600_multistate_avx2<num_rounds>(lanes);
+      break;
+#endif
+    default:
+      keccak_p1600_multistate_vec128<num_rounds>(lanes);
+      break;
+  }
+}
+
+/**
+ * Sponges of `num_states`-many independent XOF instances of kind `xof_kind`, in lane-major layout, which are absorbed into,
+ * permuted, squeezed and ratcheted in lock-step, so that every permutation runs on all of them, side-by-side. Each of them
+ * produces exactly the same byte stream, as an instance of `xof_selector_t<xof_kind>::type`, absorbing the same message,
+ * squeezed in whole rate blocks and ratcheted at the same points, does. See the compile-time check below.
+ */
+template<xof_kind_t xof_kind, size_t num_states>
+  requires(check_endianness() && (xof_kind != xof_kind_t::TURBOSHAKE256_TREE) && (num_states > 0))
+struct multistate_sponge_t
+{
+public:
+  static constexpr size_t rate_byte_len = xof_selector_t<xof_kind>::rate / std::numeric_limits<uint8_t>::digits;
+
+private:
+  static constexpr size_t rate_lane_cnt = rate_byte_len / sizeof(uint64_t);
+  static constexpr size_t ratchet_lane_cnt = xof_selector_t<xof_kind>::ratchet_byte_len / sizeof(uint64_t);
+
+  static_assert(rate_byte_len % sizeof(uint64_t) == 0, "Rate must be a multiple of lane width, for blocks to be squeezed lane-by-lane !");
+  static_assert(xof_selector_t<xof_kind>::ratchet_byte_len % sizeof(uint64_t) == 0, "Ratchet must zeroize whole lanes !");
+
+public:
+  keccak_lanes_t<num_states> lanes{};
+
+  // Set once current rate block of every state has been squeezed out, so that next block must be permuted into place first.
+  bool is_block_squeezed = false;
+
+  // Zeroizes all states, making them ready for absorbing a new message.
+  forceinline constexpr void reset()
+  {
+    for (auto& lane : lanes) {
+      lane.fill(0);
+    }
+
+    is_block_squeezed = false;
+  }
+
+  // Absorbs `block`, holding at most `rate_byte_len` -bytes, into state `state_idx`. Call `permute`, before absorbing another.
+  forceinline constexpr void absorb_block(const size_t state_idx, std::span<const uint8_t> block)
+  {
+    for (size_t byte_idx = 0; byte_idx < block.size(); byte_idx++) {
+      lanes[byte_idx / sizeof(uint64_t)][state_idx] ^= static_cast<uint64_t>(block[byte_idx]) << ((byte_idx % sizeof(uint64_t)) * 8);
+    }
+  }
+
+  // Appends domain separation bits and 10*1 padding to the last block, holding `msg_byte_len` -bytes, absorbed into state `state_idx`.
+  forceinline constexpr void pad(const size_t state_idx, const size_t msg_byte_len)
+  {
+    constexpr std::array<uint8_t, rate_byte_len> last_padding_byte = []() {
+      std::array<uint8_t, rate_byte_len> bytes{};
+      bytes.back() = 0x80;
+
+      return bytes;
+    }();
+
+    absorb_block(state_idx, last_padding_byte);
+    lanes[msg_byte_len / sizeof(uint64_t)][state_idx] ^= uint64_t{ xof_selector_t<xof_kind>::domain_separator } << ((msg_byte_len % sizeof(uint64_t)) * 8);
+  }
+
+  // Applies the permutation on all states.
+  forceinline constexpr void permute() { keccak_p1600_multistate<xof_selector_t<xof_kind>::num_rounds>(lanes); }
+
+  // Finalizes all states, once their last block has been absorbed and padded, making them ready for squeezing.
+  forceinline constexpr void finalize()
+  {
+    permute();
+    is_block_squeezed = false;
+  }
+
+  /**
+   * Squeezes next rate block of every state, in one permutation over all of them. Rate block of state s is written into the
+   * `rate_byte_len` -bytes span returned by `block_of(s)`.
+   */
+  template<typename block_of_t>
+    requires(std::is_invocable_r_v<std::span<uint8_t, rate_byte_len>, block_of_t, size_t>)
+  forceinline constexpr void squeeze_block(block_of_t&& block_of)
+  {
+    if (is_block_squeezed) {
+      permute();
+    }
+
+    for (size_t state_idx = 0; state_idx < num_states; state_idx++) {
+      const std::span<uint8_t, rate_byte_len> block = block_of(state_idx);
+
+      for (size_t lane_idx = 0; lane_idx < rate_lane_cnt; lane_idx++) {
+        const uint64_t lane = lanes[lane_idx][state_idx];
+
+        if (std::is_constant_evaluated()) {
+          for (size_t byte_idx = 0; byte_idx < sizeof(lane); byte_idx++) {
+            block[lane_idx * sizeof(lane) + byte_idx] = static_cast<uint8_t>(lane >> (byte_idx * 8));
+          }
+        } else {
+          std::memcpy(block.subspan(lane_idx * sizeof(lane), sizeof(lane)).data(), &lane, sizeof(lane));
+        }
+      }
+    }
+
+    is_block_squeezed = true;
+  }
+
+  /**
+   * Ratchets every state, by zeroizing first `ratchet_byte_len` -bytes of it and re-applying the permutation, just like the
+   * XOF does. Zeroized block is the one the XOF holds in between two squeezes, which is the next one, if it permutes eagerly.
+   */
+  forceinline constexpr void ratchet()
+  {
+    constexpr bool permutes_eagerly = xof_permutes_eagerly<typename xof_selector_t<xof_kind>::type, rate_byte_len>();
+    if (permutes_eagerly && is_block_squeezed) {
+      permute();
+    }
+
+    for (size_t lane_idx = 0; lane_idx < ratchet_lane_cnt; lane_idx++) {
+      lanes[lane_idx].fill(0);
+    }
+
+    permute();
+    is_block_squeezed = false;
+  }
+};
+
+/**
+ * Checks, at compile-time, that the sponges above produce the same byte stream, as XOF of kind `xof_kind`, absorbing a message
+ * spanning two blocks, which is then squeezed and ratcheted, twice.
+ */
+template<xof_kind_t xof_kind>
+consteval bool
+multistate_sponge_matches_xof()
+{
+  using sponge_t = multistate_sponge_t<xof_kind, 2>;
+  constexpr size_t rate_byte_len = sponge_t::rate_byte_len;
+
+  std::array<uint8_t, rate_byte_len + 3> msg{};
+  for (size_t i = 0; i < msg.size(); i++) {
+    msg[i] = static_cast<uint8_t>(i * 7 + 1);
+  }
+
+  const auto msg_span = std::span<const uint8_t>(msg);
+
+  sponge_t sponge{};
+  sponge.reset();
+  for (size_t state_idx = 0; state_idx < 2; state_idx++) {
+    sponge.absorb_block(state_idx, msg_span.first(rate_byte_len));
+  }
+  sponge.permute();
+  for (size_t state_idx = 0; state_idx < 2; state_idx++) {
+    sponge.absorb_block(state_idx, msg_span.subspan(rate_byte_len));
+    sponge.pad(state_idx, msg.size() - rate_byte_len);
+  }
+  sponge.finalize();
+
+  typename xof_selector_t<xof_kind>::type xof{};
+  xof.reset();
+  xof.absorb(msg);
+  xof.finalize();
+
+  std::array<uint8_t, 2 * rate_byte_len> expected{};
+  std::array<uint8_t, 4 * rate_byte_len> computed{};
+
+  bool is_same = true;
+  for (size_t period_idx = 0; period_idx < 2; period_idx++) {
+    if (period_idx > 0) {
+      xof.ratchet(xof_selector_t<xof_kind>::ratchet_byte_len);
+      sponge.ratchet();
+    }
+
+    xof.squeeze(expected);
+    for (size_t block_idx = 0; block_idx < 2; block_idx++) {
+      sponge.squeeze_block([&](const size_t state_idx) {
+        return std::span(computed).subspan((state_idx * 2 + block_idx) * rate_byte_len).template first<rate_byte_len>();
+      });
+    }
+
+    is_same &= std::equal(expected.begin(), expected.end(), computed.begin());
+    is_same &= std::equal(expected.begin(), expected.end(), computed.begin() + expected.size());
+  }
+
+  return is_same;
+}
+
+static_assert(multistate_sponge_matches_xof<xof_kind_t::SHAKE256>(), "Multi-state sponge must produce the same stream as SHAKE256 XOF !");
+static_assert(multistate_sponge_matches_xof<xof_kind_t::TURBOSHAKE256>(), "Multi-state sponge must produce the same stream as TurboSHAKE256 XOF !");
+static_assert(multistate_sponge_matches_xof<xof_kind_t::SHAKE128>(), "Multi-state sponge must produce the same stream as SHAKE128 XOF !");
+static_assert(multistate_sponge_matches_xof<xof_kind_t::TURBOSHAKE128>(), "Multi-state sponge must produce the same stream as TurboSHAKE128 XOF !");
+
+}
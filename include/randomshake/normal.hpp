@@ -0,0 +1,275 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace randomshake {
+
+/**
+ * Layer boundaries of the 256-layer Ziggurat, covering the right half of the standard normal density f(x) = exp(-x^2 / 2),
+ * following G. Marsaglia and W. W. Tsang, "The Ziggurat Method for Generating Random Variables", https://doi.org/10.18637/jss.v005.i08.
+ *
+ * Layer i, for i in [1, 256), is the rectangle [0, x[i]) x [f(x[i]), f(x[i + 1])), while layer 0 is the base strip of width
+ * x[0] = V / f(R), standing for the rectangle [0, R) x [0, f(R)) together with the tail beyond R. All layers have area V.
+ */
+struct ziggurat_normal_table_t
+{
+  static constexpr size_t NUM_LAYERS = 256;
+  static constexpr double R = 3.6541528853610088;
+  static constexpr double V = 4.92867323399e-3;
+
+  std::array<double, NUM_LAYERS + 1> x{};
+  std::array<double, NUM_LAYERS + 1> f{};
+
+  static double density(const double val) { return std::exp(-0.5 * val * val); }
+
+  ziggurat_normal_table_t()
+  {
+    x[0] = V / density(R);
+    x[1] = R;
+    for (size_t i = 1; i < NUM_LAYERS - 1; i++) {
+      x[i + 1] = std::sqrt(-2. * std::log((V / x[i]) + density(x[i])));
+    }
+    x[NUM_LAYERS] = 0.;
+
+    std::ranges::transform(x, f.begin(), density);
+  }
+};
+
+// Returns the Ziggurat table, which is computed only once, on first call.
+forceinline const ziggurat_normal_table_t&
+ziggurat_normal_table()
+{
+  static const ziggurat_normal_table_t table{};
+  return table;
+}
+
+/**
+ * Maps a random 64-bit word onto the Ziggurat, consuming 8 bits for layer index, 1 bit for sign and top 53 bits for the
+ * position within the layer. Returns the layer index and the signed position.
+ */
+forceinline std::pair<size_t, double>
+ziggurat_normal_decode(const ziggurat_normal_table_t& table, const uint64_t word)
+{
+  constexpr double scale = 1. / static_cast<double>(uint64_t{ 1 } << std::numeric_limits<double>::digits);
+
+  const auto layer = static_cast<size_t>(word & (ziggurat_normal_table_t::NUM_LAYERS - 1));
+  const auto sign = static_cast<double>(1 - static_cast<int>((word >> 8) & 1U) * 2);
+  const auto unit = static_cast<double>(word >> (std::numeric_limits<uint64_t>::digits - std::numeric_limits<double>::digits)) * scale;
+
+  return { layer, sign * unit * table.x[layer] };
+}
+
+// Squeezes a single random 64-bit word and converts it to a floating-point value in (0, 1]. The word is zeroized after use.
+template<typename csprng_t>
+  requires(bulk_generator<csprng_t, uint64_t>)
+forceinline double
+draw_open_closed_unit(csprng_t& csprng)
+{
+  constexpr double scale = 1. / static_cast<double>(uint64_t{ 1 } << std::numeric_limits<double>::digits);
+
+  std::array<uint64_t, 1> word{};
+  csprng.generate(std::span<uint64_t>(word));
+
+  const double unit = static_cast<double>((word[0] >> (std::numeric_limits<uint64_t>::digits - std::numeric_limits<double>::digits)) + 1) * scale;
+
+  word.fill(0);
+  DoNotOptimize(word);
+
+  return unit;
+}
+
+/**
+ * Slow path of the Ziggurat method, taken when `word` doesn't map inside the rectangular core of its layer. Samples from the
+ * tail (for base strip) or tests the wedge (for other layers), drawing fresh random words, one at a time, on rejection.
+ */
+template<typename csprng_t>
+  requires(bulk_generator<csprng_t, uint64_t>)
+double
+ziggurat_normal_slow_path(csprng_t& csprng, const ziggurat_normal_table_t& table, uint64_t word)
+{
+  while (true) {
+    const auto [layer, val] = ziggurat_normal_decode(table, word);
+    const double abs_val = std::abs(val);
+
+    if (abs_val < table.x[layer + 1]) {
+      return val;
+    }
+
+    if (layer == 0) {
+      // Marsaglia's method for sampling from the tail beyond R.
+      double tail_x = 0.;
+      double tail_y = 0.;
+      do {
+        tail_x = -std::log(draw_open_closed_unit(csprng)) / ziggurat_normal_table_t::R;
+        tail_y = -std::log(draw_open_closed_unit(csprng));
+      } while ((tail_y + tail_y) < (tail_x * tail_x));
+
+      return std::copysign(ziggurat_normal_table_t::R + tail_x, val);
+    }
+
+    const double wedge_y = table.f[layer] + (draw_open_closed_unit(csprng) * (table.f[layer + 1] - table.f[layer]));
+    if (wedge_y < ziggurat_normal_table_t::density(abs_val)) {
+      return val;
+    }
+
+    std::array<uint64_t, 1> fresh_word{};
+    csprng.generate(std::span<uint64_t>(fresh_word));
+    word = fresh_word[0];
+
+    fresh_word.fill(0);
+    DoNotOptimize(fresh_word);
+  }
+}
+
+/**
+ * Fills `output` with values sampled from the normal distribution of given mean and standard deviation, using the 256-layer
+ * Ziggurat method, on random 64-bit words squeezed from `csprng` in bulk.
+ *
+ * About 99% of the words land inside the rectangular core of their layer, for which the value is obtained by a single
+ * multiplication and comparison, in a branch-free pass over a whole chunk. The remaining ones are handled in a separate pass,
+ * which may evaluate the density and draw more words, one at a time. Output is a deterministic function of the CSPRNG's
+ * output stream. Squeezed words, including the ones drawn one at a time, are zeroized before returning. Note, timing of this
+ * function depends on the sampled values, so it is not suitable where that matters.
+ */
+template<typename csprng_t, std::floating_point F>
+  requires(bulk_generator<csprng_t, uint64_t>)
+forceinline void
+normal_fill(csprng_t& csprng, std::span<F> output, const std::type_identity_t<F> mean = 0, const std::type_identity_t<F> stddev = 1)
+{
+  constexpr size_t CHUNK_LEN = 256;
+
+  const auto& table = ziggurat_normal_table();
+
+  std::array<uint64_t, CHUNK_LEN> words{};
+  auto words_span = std::span(words);
+
+  for (size_t out_offset = 0; out_offset < output.size(); out_offset += CHUNK_LEN) {
+    const size_t chunk_len = std::min(CHUNK_LEN, output.size() - out_offset);
+    auto chunk = words_span.first(chunk_len);
+    auto out_chunk = output.subspan(out_offset, chunk_len);
+
+    csprng.generate(chunk);
+
+    // Branch-free pass, mapping every word onto the rectangular core of its layer, while noting whether any word missed it.
+    bool any_missed_core = false;
+    for (size_t i = 0; i < chunk_len; i++) {
+      const auto [layer, val] = ziggurat_normal_decode(table, chunk[i]);
+
+      out_chunk[i] = static_cast<F>(val);
+      any_missed_core |= (std::abs(val) >= table.x[layer + 1]);
+    }
+
+    if (any_missed_core) {
+      for (size_t i = 0; i < chunk_len; i++) {
+        const auto [layer, val] = ziggurat_normal_decode(table, chunk[i]);
+        if (std::abs(val) >= table.x[layer + 1]) {
+          out_chunk[i] = static_cast<F>(ziggurat_normal_slow_path(csprng, table, chunk[i]));
+        }
+      }
+    }
+
+    std::ranges::transform(out_chunk, out_chunk.begin(), [=](const F val) { return mean + stddev * val; });
+  }
+
+  words.fill(0);
+  DoNotOptimize(words);
+}
+
+/**
+ * Constant-time sampler for the discrete Gaussian distribution over integers, centered at 0, with parameter `sigma`, i.e.
+ * Pr[X = x] is proportional to exp(-x^2 / (2 * sigma^2)), as used for noise sampling in lattice-based cryptography.
+ *
+ * A cumulative distribution table (CDT) of |X| is computed once, at construction, with 63-bit fixed-point precision, for
+ * |X| <= ceil(TAIL_CUT * sigma). Each sample consumes one random 64-bit word : 63 bits are compared against every entry of the
+ * table, without any branch or early exit, and the remaining bit chooses the sign. Hence sampling time is independent of
+ * sampled values. Note, table entries are computed in `long double` arithmetic, so their precision is bounded by that of
+ * `long double` on the target platform, which is 53 bits, when it is the same as `double`.
+ */
+struct discrete_gaussian_cdt_t
+{
+private:
+  std::vector<uint64_t> cdt{};
+
+public:
+  // Samples are restricted to [-ceil(TAIL_CUT * sigma), ceil(TAIL_CUT * sigma)]. Probability mass beyond it is < 2^-70,
+  // which is anyway below the 63-bit precision of the table.
+  static constexpr double TAIL_CUT = 10.;
+
+  // Builds the cumulative distribution table for given `sigma` (> 0).
+  explicit discrete_gaussian_cdt_t(const double sigma)
+  {
+    const auto max_abs_val = static_cast<size_t>(std::ceil(TAIL_CUT * sigma));
+    const auto two_sigma_sq = static_cast<long double>(2. * sigma * sigma);
+
+    // Probability mass of each |X| = k is rho(k) for k = 0 and 2 * rho(k) for k > 0.
+    std::vector<long double> mass(max_abs_val + 1, 0.L);
+    long double total_mass = 0.L;
+    for (size_t k = 0; k <= max_abs_val; k++) {
+      const auto kf = static_cast<long double>(k);
+      mass[k] = ((k == 0) ? 1.L : 2.L) * std::exp(-(kf * kf) / two_sigma_sq);
+      total_mass += mass[k];
+    }
+
+    // cdt[k] = floor(2^63 * Pr[|X| <= k]), for k in [0, max_abs_val). Last entry would be 2^63, so it is not stored.
+    constexpr auto scale = static_cast<long double>(uint64_t{ 1 } << 63);
+
+    cdt.resize(max_abs_val);
+    long double cumulative_mass = 0.L;
+    for (size_t k = 0; k < max_abs_val; k++) {
+      cumulative_mass += mass[k];
+      cdt[k] = static_cast<uint64_t>(std::floor(std::min(cumulative_mass / total_mass, 1.L) * scale));
+    }
+  }
+
+  // Largest absolute value, which can ever be sampled.
+  [[nodiscard]] size_t max_abs_value() const { return cdt.size(); }
+
+  // Maps a random 64-bit word onto a discrete Gaussian sample, in constant-time.
+  [[nodiscard]] int64_t sample(const uint64_t word) const
+  {
+    const uint64_t rand63 = word >> 1;
+    const auto sign = static_cast<int64_t>(word & 1U);
+
+    // Count table entries <= rand63, which is |X|. (entry - rand63 - 1) borrows into the top bit iff entry <= rand63.
+    uint64_t abs_val = 0;
+    for (const auto entry : cdt) {
+      abs_val += (entry - rand63 - 1) >> 63;
+    }
+
+    // Conditionally negate, without branching.
+    return (static_cast<int64_t>(abs_val) ^ -sign) + sign;
+  }
+
+  // Fills `output` with discrete Gaussian samples, consuming one random 64-bit word per sample, squeezed from `csprng` in bulk.
+  template<typename csprng_t, std::signed_integral T>
+    requires(bulk_generator<csprng_t, uint64_t>)
+  void fill(csprng_t& csprng, std::span<T> output) const
+  {
+    constexpr size_t CHUNK_LEN = 256;
+
+    std::array<uint64_t, CHUNK_LEN> words{};
+    auto words_span = std::span(words);
+
+    for (size_t out_offset = 0; out_offset < output.size(); out_offset += CHUNK_LEN) {
+      const size_t chunk_len = std::min(CHUNK_LEN, output.size() - out_offset);
+      auto chunk = words_span.first(chunk_len);
+
+      csprng.generate(chunk);
+      std::ranges::transform(chunk, output.subspan(out_offset, chunk_len).begin(), [this](const uint64_t word) { return static_cast<T>(sample(word)); });
+    }
+
+    words.fill(0);
+    DoNotOptimize(words);
+  }
+};
+
+}
@@ -1,41 +1,32 @@
 #pragma once
+#include "randomshake/entropy_source.hpp"
+#include "randomshake/utils.hpp"
 #include "sha3/internals/force_inline.hpp"
+#include "sha3/shake128.hpp"
 #include "sha3/shake256.hpp"
+#include "sha3/turboshake128.hpp"
 #include "sha3/turboshake256.hpp"
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
-#include <iostream>
 #include <limits>
 #include <random>
+#include <span>
 #include <type_traits>
 
 namespace randomshake {
 
-// Compile-time check to ensure that endianness is little, as correctness of program depends on it.
-consteval auto
-check_endianness()
-{
-  return std::endian::native == std::endian::little;
-}
-
-/**
- * Ensures that value is materialized (and not optimized away), but doesn't clobber memory, like google-benchmark does.
- * Taken from https://theunixzoo.co.uk/blog/2021-10-14-preventing-optimisations.html.
- */
-template<typename Tp>
-forceinline void
-DoNotOptimize(Tp& value)
-{
-  asm volatile("" : "+r,m"(value) : :); // NOLINT(hicpp-no-assembler)
-}
-
 // Enum listing supported eXtendable Output Functions (XOFs), which can be used for producing pseudo-random byte stream.
 enum class xof_kind_t : uint8_t
 {
-  SHAKE256,      // Based on 24-rounds keccak permutation.
-  TURBOSHAKE256, // Based on 12-rounds keccak permutation. Almost doubles the throughput. The default choice.
+  SHAKE256,           // Based on 24-rounds keccak permutation.
+  TURBOSHAKE256,      // Based on 12-rounds keccak permutation. Almost doubles the throughput. The default choice.
+  SHAKE128,           // Based on 24-rounds keccak permutation, offering 128-bit security. ~23% larger rate than SHAKE256.
+  TURBOSHAKE128,      // Based on 12-rounds keccak permutation, offering 128-bit security. ~23% larger rate than TurboSHAKE256.
+  TURBOSHAKE256_TREE, // Tree of 8 TurboSHAKE256 leaf sponges, permuted side-by-side. For very long output. Include `tree_xof.hpp`.
 };
 
 // A helper trait, for selecting which XOF to use in RandomSHAKE CSPRNG.
@@ -55,6 +46,12 @@ struct xof_selector_t<xof_kind_t::SHAKE256>
   // Required seed byte length to initialize the SHAKE256 XOF.
   static constexpr size_t seed_byte_len = rate / std::numeric_limits<uint8_t>::digits;
 
+  // Number of rounds of Keccak-p[1600] permutation, applied by SHAKE256 XOF.
+  static constexpr size_t num_rounds = 24;
+
+  // Domain separation bits, which SHAKE256 XOF appends to absorbed message, before applying 10*1 padding.
+  static constexpr uint8_t domain_separator = 0x1f;
+
   /**
    * Everytime these many bytes are squeezed from the underlying keccak sponge,
    * we zeroize first `ratchet_byte_len`-bytes of Keccak permutation state and re-apply 24-rounds permutation.
@@ -79,6 +76,12 @@ struct xof_selector_t<xof_kind_t::TURBOSHAKE256>
   // Required seed byte length to initialize the TurboSHAKE256 XOF.
   static constexpr size_t seed_byte_len = rate / std::numeric_limits<uint8_t>::digits;
 
+  // Number of rounds of Keccak-p[1600] permutation, applied by TurboSHAKE256 XOF.
+  static constexpr size_t num_rounds = 12;
+
+  // Domain separation bits, which TurboSHAKE256 XOF appends to absorbed message, before applying 10*1 padding.
+  static constexpr uint8_t domain_separator = 0x1f;
+
   /**
    * Everytime these many bytes are squeezed from the underlying keccak sponge,
    * we zeroize first `ratchet_byte_len`-bytes of Keccak permutation state and re-apply 12-rounds permutation.
@@ -91,25 +94,269 @@ struct xof_selector_t<xof_kind_t::TURBOSHAKE256>
   static constexpr size_t ratchet_byte_len = turboshake256::TARGET_BIT_SECURITY_LEVEL / std::numeric_limits<uint8_t>::digits;
 };
 
+// Specialization for SHAKE128 XOF.
+template<>
+struct xof_selector_t<xof_kind_t::SHAKE128>
+{
+  using type = shake128::shake128_t;
+
+  // Bit width of the rate portion of keccak sponge for SHAKE128 XOF.
+  static constexpr size_t rate = shake128::RATE;
+
+  // Required seed byte length to initialize the SHAKE128 XOF.
+  static constexpr size_t seed_byte_len = rate / std::numeric_limits<uint8_t>::digits;
+
+  // Number of rounds of Keccak-p[1600] permutation, applied by SHAKE128 XOF.
+  static constexpr size_t num_rounds = 24;
+
+  // Domain separation bits, which SHAKE128 XOF appends to absorbed message, before applying 10*1 padding.
+  static constexpr uint8_t domain_separator = 0x1f;
+
+  /**
+   * Everytime these many bytes are squeezed from the underlying keccak sponge,
+   * we zeroize first `ratchet_byte_len`-bytes of Keccak permutation state and re-apply 24-rounds permutation.
+   *
+   * Ratchet period gets computed as `8 x RATE-of-the-underlying-keccak-sponge` bits.
+   */
+  static constexpr size_t ratchet_period_byte_len = shake128::RATE;
+
+  // First these many bytes of keccak permutation state are zeroized during ratcheting.
+  static constexpr size_t ratchet_byte_len = shake128::TARGET_BIT_SECURITY_LEVEL / std::numeric_limits<uint8_t>::digits;
+};
+
+// Specialization for TurboSHAKE128 XOF.
+template<>
+struct xof_selector_t<xof_kind_t::TURBOSHAKE128>
+{
+  using type = turboshake128::turboshake128_t;
+
+  // Bit width of the rate portion of keccak sponge for TurboSHAKE128 XOF.
+  static constexpr size_t rate = turboshake128::RATE;
+
+  // Required seed byte length to initialize the TurboSHAKE128 XOF.
+  static constexpr size_t seed_byte_len = rate / std::numeric_limits<uint8_t>::digits;
+
+  // Number of rounds of Keccak-p[1600] permutation, applied by TurboSHAKE128 XOF.
+  static constexpr size_t num_rounds = 12;
+
+  // Domain separation bits, which TurboSHAKE128 XOF appends to absorbed message, before applying 10*1 padding.
+  static constexpr uint8_t domain_separator = 0x1f;
+
+  /**
+   * Everytime these many bytes are squeezed from the underlying keccak sponge,
+   * we zeroize first `ratchet_byte_len`-bytes of Keccak permutation state and re-apply 12-rounds permutation.
+   *
+   * Ratchet period gets computed as `8 x RATE-of-the-underlying-keccak-sponge` bits.
+   */
+  static constexpr size_t ratchet_period_byte_len = turboshake128::RATE;
+
+  // First these many bytes of keccak permutation state are zeroized during ratcheting.
+  static constexpr size_t ratchet_byte_len = turboshake128::TARGET_BIT_SECURITY_LEVEL / std::numeric_limits<uint8_t>::digits;
+};
+
+/**
+ * Number of rate blocks squeezed from the underlying XOF instance, between two consecutive ratchets, unless asked otherwise.
+ * It is 8, for all supported XOFs.
+ */
+template<xof_kind_t xof_kind>
+inline constexpr size_t default_ratchet_period_block_count =
+  xof_selector_t<xof_kind>::ratchet_period_byte_len / (xof_selector_t<xof_kind>::rate / std::numeric_limits<uint8_t>::digits);
+
+/**
+ * Any CSPRNG, which is able to fill a span of `T` values in bulk, such as `randomshake_t` or `randomshake_seekable_t`.
+ * Samplers, built on top of the CSPRNG, consume random values through this interface.
+ */
+template<typename csprng_t, typename T>
+concept bulk_generator = std::is_unsigned_v<T> && requires(csprng_t& csprng, std::span<T> output) { csprng.generate(output); };
+
+// Domain separation label, absorbed first, when re-initializing a RandomSHAKE CSPRNG instance during reseeding.
+inline constexpr auto RESEED_DOMAIN = make_domain_label("RandomSHAKE/reseed");
+
+// Leading bytes of every exported RandomSHAKE CSPRNG state, identifying the format.
+inline constexpr auto EXPORTED_STATE_MAGIC = make_domain_label("RSHK");
+
+// Version of the binary format of exported RandomSHAKE CSPRNG state. Bumped on every incompatible change.
+inline constexpr uint8_t EXPORTED_STATE_FORMAT_VERSION = 1;
+
+/**
+ * Byte length of the header of exported RandomSHAKE CSPRNG state, which is
+ *
+ * MAGIC || VERSION || XOF_KIND || LE16(RATCHET_PERIOD_BLOCK_COUNT) || LE16(SQUEEZE_OFFSET) || LE32(UNREAD_LEN)
+ */
+inline constexpr size_t EXPORTED_STATE_HEADER_BYTE_LEN = EXPORTED_STATE_MAGIC.size() + 1 + 1 + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+// Byte length of Keccak-p[1600] permutation state, which is exported as 25 little-endian lanes, each of 64 -bits.
+inline constexpr size_t EXPORTED_KECCAK_STATE_BYTE_LEN = 25 * sizeof(uint64_t);
+
+// Domain separation label, absorbed first, when computing the checksum, trailing every exported RandomSHAKE CSPRNG state.
+inline constexpr auto EXPORTED_STATE_CHECKSUM_DOMAIN = make_domain_label("RandomSHAKE/exported-state");
+
+// Byte length of the checksum, trailing every exported RandomSHAKE CSPRNG state.
+inline constexpr size_t EXPORTED_STATE_CHECKSUM_BYTE_LEN = 32;
+
 /**
- * RandomSHAKE - TurboSHAKE256 (by default) or SHAKE256-backed Cryptographically Secure Pseudo-Random Number Generator (CSPRNG).
+ * Checks, at compile-time, that object representation of an instance of XOF type `xof_t` starts with its Keccak-p[1600]
+ * permutation state, laid out as 25 little-endian lanes, by absorbing a known message, which doesn't fill the rate, and
+ * finding it there. Exporting and importing the lanes of the sponge relies on it.
+ */
+template<typename xof_t, size_t rate_byte_len>
+consteval bool
+keccak_state_leads_object_representation()
+{
+  std::array<uint8_t, rate_byte_len - 1> msg{};
+  for (size_t i = 0; i < msg.size(); i++) {
+    msg[i] = static_cast<uint8_t>(i + 1);
+  }
+
+  xof_t xof{};
+  xof.reset();
+  xof.absorb(msg);
+
+  const auto object_repr = std::bit_cast<std::array<uint8_t, sizeof(xof_t)>>(xof);
+  return (sizeof(xof_t) >= EXPORTED_KECCAK_STATE_BYTE_LEN) && std::equal(msg.begin(), msg.end(), object_repr.begin()) &&
+         std::all_of(object_repr.begin() + msg.size(), object_repr.begin() + EXPORTED_KECCAK_STATE_BYTE_LEN, [](const uint8_t byte) { return byte == 0; });
+}
+
+/**
+ * Checks, at compile-time, whether XOF type `xof_t` applies the permutation as soon as a rate block is squeezed out of it,
+ * rather than right before the next rate block is squeezed, by squeezing a whole rate block and looking for it in the lanes.
+ * It tells whether lanes of a sponge, in between two whole-block squeezes, hold the last squeezed rate block or the next one.
+ */
+template<typename xof_t, size_t rate_byte_len>
+consteval bool
+xof_permutes_eagerly()
+{
+  std::array<uint8_t, rate_byte_len> block{};
+
+  xof_t xof{};
+  xof.reset();
+  xof.finalize();
+  xof.squeeze(block);
+
+  const auto object_repr = std::bit_cast<std::array<uint8_t, sizeof(xof_t)>>(xof);
+  return !std::equal(block.begin(), block.end(), object_repr.begin());
+}
+
+/**
+ * RandomSHAKE - TurboSHAKE256 (by default), SHAKE256, TurboSHAKE128 or SHAKE128-backed Cryptographically Secure Pseudo-Random
+ * Number Generator (CSPRNG).
  *
- * Allowing both (a) `std::random_device` sampled seed, (b) User provided seed-based initialization of CSPRNG.
+ * Allowing both (a) entropy source sampled seed, (b) User provided seed-based initialization of CSPRNG.
  * After every `ratchet_period_byte_len`-many bytes are squeezed from the underlying XOF instance, we perform
  * ratcheting i.e. zeroing out of first `ratchet_byte_len` -many bytes of Keccak permutation state and re-applying
  * permutation.
  *
  * Design of RandomSHAKE CSPRNG API collects inspiration from https://seth.rocks/articles/cpprandom.
  */
-template<typename UIntType = uint8_t, xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256>
-  requires(std::is_unsigned_v<UIntType> && check_endianness())
+template<typename UIntType = uint8_t,
+         xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256,
+         size_t ratchet_period_block_count = default_ratchet_period_block_count<xof_kind>>
+  requires(std::is_unsigned_v<UIntType> && check_endianness() && (ratchet_period_block_count > 0) &&
+           (ratchet_period_block_count <= std::numeric_limits<uint16_t>::max()))
 struct randomshake_t
 {
+public:
+  /**
+   * Everytime these many bytes are squeezed from the underlying XOF instance, it is ratcheted. Defaults to 8 rate blocks.
+   * Fewer blocks bound more tightly how much past output can be recovered from a compromised state, while more blocks
+   * amortize the cost of ratcheting over more output bytes, at the expense of a larger internal buffer.
+   */
+  static constexpr size_t ratchet_period_byte_len = ratchet_period_block_count * (xof_selector_t<xof_kind>::rate / std::numeric_limits<uint8_t>::digits);
+
 private:
   xof_selector_t<xof_kind>::type state{};
-  std::array<uint8_t, xof_selector_t<xof_kind>::ratchet_period_byte_len> buffer{};
+  std::array<uint8_t, ratchet_period_byte_len> buffer{};
   size_t buffer_offset = 0U;
 
+  // Set on the instance whose state has been moved out, as it no longer has any secret state to produce output from.
+  bool is_moved_from = false;
+
+  static constexpr size_t rate_byte_len = xof_selector_t<xof_kind>::rate / std::numeric_limits<uint8_t>::digits;
+
+  /**
+   * Checks, at compile-time, that state of the underlying XOF can be exported. Only instantiated by `export_state` and
+   * `import_state`, so that XOFs which don't keep a single sponge, such as the tree XOF, can still back the CSPRNG.
+   */
+  static consteval void check_state_is_exportable()
+  {
+    static_assert(xof_kind != xof_kind_t::TURBOSHAKE256_TREE, "State of tree XOF, spread over many leaf sponges, can't be exported !");
+    static_assert(std::is_trivially_copyable_v<typename xof_selector_t<xof_kind>::type>, "XOF state must be trivially copyable, for it to be exported !");
+    static_assert(keccak_state_leads_object_representation<typename xof_selector_t<xof_kind>::type, rate_byte_len>(),
+                  "XOF state must start with Keccak-p[1600] lanes, for it to be exported !");
+    static_assert(ratchet_period_byte_len <= std::numeric_limits<uint32_t>::max(), "Buffer byte length must fit in 32 -bits, for it to be exported !");
+  }
+
+  // Zeroizes XOF state and the buffer of squeezed bytes, so that no output can be recovered from this instance.
+  forceinline void zeroize()
+  {
+    state.reset();
+    DoNotOptimize(state);
+
+    buffer.fill(0);
+    DoNotOptimize(buffer);
+
+    buffer_offset = 0;
+  }
+
+  // Zeroizes the instance whose state has been moved out, leaving its buffer exhausted, so that any use of it fails loudly.
+  forceinline void mark_moved_from()
+  {
+    zeroize();
+
+    buffer_offset = buffer.size();
+    is_moved_from = true;
+  }
+
+  /**
+   * Aborts the process, if this instance has been moved from, instead of producing a predictable output stream from zeroized
+   * state. Checked only when the buffer needs to be refilled, which is always the case for a moved-from instance.
+   */
+  forceinline void ensure_not_moved_from() const
+  {
+    if (is_moved_from) [[unlikely]] {
+      std::abort();
+    }
+  }
+
+  // Overwrites `dst` with `src`, if `mask` is all-ones, leaves it as-is, if it is all-zeros, touching every byte of both in either case.
+  template<typename T>
+    requires(std::is_trivially_copyable_v<T>)
+  forceinline static void ct_assign(const uint8_t mask, T& dst, const T& src)
+  {
+    std::array<uint8_t, sizeof(T)> dst_bytes{};
+    std::array<uint8_t, sizeof(T)> src_bytes{};
+
+    std::memcpy(dst_bytes.data(), &dst, sizeof(T));
+    std::memcpy(src_bytes.data(), &src, sizeof(T));
+
+    for (size_t i = 0; i < sizeof(T); i++) {
+      dst_bytes[i] ^= static_cast<uint8_t>((dst_bytes[i] ^ src_bytes[i]) & mask);
+    }
+
+    std::memcpy(&dst, dst_bytes.data(), sizeof(T));
+
+    dst_bytes.fill(0);
+    src_bytes.fill(0);
+
+    DoNotOptimize(dst_bytes);
+    DoNotOptimize(src_bytes);
+  }
+
+  // Computes checksum of exported state, as first `EXPORTED_STATE_CHECKSUM_BYTE_LEN` -bytes squeezed from XOF(DOMAIN || MSG).
+  forceinline static void checksum(std::span<const uint8_t> msg, std::span<uint8_t, EXPORTED_STATE_CHECKSUM_BYTE_LEN> digest)
+  {
+    typename xof_selector_t<xof_kind>::type hasher{};
+
+    hasher.reset();
+    hasher.absorb(EXPORTED_STATE_CHECKSUM_DOMAIN);
+    hasher.absorb(msg);
+    hasher.finalize();
+    hasher.squeeze(digest);
+
+    hasher.reset();
+    DoNotOptimize(hasher);
+  }
+
 public:
   using result_type = UIntType;
 
@@ -117,37 +364,36 @@ public:
   static constexpr auto min = std::numeric_limits<result_type>::min;
   static constexpr auto max = std::numeric_limits<result_type>::max;
 
+  // Maximum byte length of the exported state of the CSPRNG. See `export_state`.
+  static constexpr size_t exported_state_max_byte_len =
+    EXPORTED_STATE_HEADER_BYTE_LEN + EXPORTED_KECCAK_STATE_BYTE_LEN + sizeof(buffer) + EXPORTED_STATE_CHECKSUM_BYTE_LEN;
+
+  // Samples `seed_byte_len` -many bytes from the default entropy source and initializes the chosen XOF - making it ready for use.
+  forceinline randomshake_t()
+    : randomshake_t(default_entropy_source_t{})
+  {
+  }
+
   /**
-   * Samples `seed_byte_len` -many bytes from std::random_device and initializes the chosen XOF - making it ready for use.
-   * Before you use this constructor, I strongly advise you to read https://en.cppreference.com/w/cpp/numeric/random/random_device.
+   * Samples `seed_byte_len` -many bytes from given entropy source and initializes the chosen XOF - making it ready for use.
+   * Use it for choosing `std::random_device` or mixing in CPU's hardware entropy source. See `entropy_source.hpp`.
    */
-  forceinline randomshake_t()
+  template<typename source_t>
+    requires(entropy_source<std::remove_cvref_t<source_t>>)
+  forceinline explicit randomshake_t(source_t&& source)
   {
     std::array<uint8_t, seed_byte_len> seed{};
     auto seed_span = std::span(seed);
 
-    std::random_device rdev{};
-    const auto entropy = rdev.entropy();
-    if (entropy == 0.) {
-      std::cout << "[RANDOMSHAKE WARNING] Non-deterministic seed generator has zero entropy ! "
-                   "Read https://en.cppreference.com/w/cpp/numeric/random/random_device/entropy for more insight.\n";
-    }
-
-    constexpr size_t step_by = sizeof(std::random_device::result_type);
-    size_t seed_offset = 0;
-    while (seed_offset < seed_span.size()) {
-      const auto val = rdev();
-
-      static_assert(seed_byte_len % step_by == 0, "Seed byte length must be a multiple of `step_by`, for following memcpy to work correctly !");
-      std::memcpy(seed_span.subspan(seed_offset, step_by).data(), &val, step_by);
-
-      seed_offset += step_by;
-    }
+    source.fill(seed_span);
 
     state.reset();
     state.absorb(seed_span);
     state.finalize();
     state.squeeze(buffer);
+
+    seed.fill(0);
+    DoNotOptimize(seed);
   }
 
   /**
@@ -162,35 +408,70 @@ public:
     state.squeeze(buffer);
   }
 
-  // Delete copy and move constructors - as this CSPRNG instance is neither copyable nor movable.
+  // Delete copy constructor and copy assignment - as this CSPRNG instance must never be cloned, producing the same output stream twice.
   randomshake_t(const randomshake_t&) = delete;
-  randomshake_t(randomshake_t&&) = delete;
   randomshake_t& operator=(const randomshake_t&) = delete;
-  randomshake_t& operator=(randomshake_t&&) = delete;
 
-  // Zeroize internal state when destroying an instance of CSPRNG.
-  ~randomshake_t()
+  /**
+   * Moves internal state of the CSPRNG into a new instance, which continues the output stream exactly where `other` left it,
+   * and zeroizes `other`, just like the destructor does, so that only one instance ever holds the state. Lets CSPRNG instances
+   * live in containers like `std::vector`, be returned from factories or be relocated. A moved-from instance must only be
+   * destroyed, assigned to or have its state imported. Squeezing from, reseeding or exporting it aborts the process.
+   */
+  forceinline randomshake_t(randomshake_t&& other) noexcept
+    : state(other.state)
+    , buffer(other.buffer)
+    , buffer_offset(other.buffer_offset)
+    , is_moved_from(other.is_moved_from)
   {
-    state.reset();
-    DoNotOptimize(state);
+    other.mark_moved_from();
+  }
 
-    buffer.fill(0);
-    DoNotOptimize(buffer);
+  // Zeroizes internal state of this instance, before taking over internal state of `other`, which is then zeroized.
+  forceinline randomshake_t& operator=(randomshake_t&& other) noexcept
+  {
+    if (this != &other) {
+      zeroize();
 
-    buffer_offset = 0;
+      state = other.state;
+      buffer = other.buffer;
+      buffer_offset = other.buffer_offset;
+      is_moved_from = other.is_moved_from;
+
+      other.mark_moved_from();
+    }
+
+    return *this;
   }
 
+  // Zeroize internal state when destroying an instance of CSPRNG.
+  ~randomshake_t() { zeroize(); }
+
   // Squeezes a random value of type `result_type`.
   [[nodiscard("Internal state of CSPRNG has changed, you should consume this value")]] forceinline result_type operator()()
   {
     constexpr size_t required_num_bytes = sizeof(result_type);
     const size_t readble_num_bytes = buffer.size() - buffer_offset;
 
-    static_assert(xof_selector_t<xof_kind>::ratchet_period_byte_len % required_num_bytes == 0,
+    static_assert(ratchet_period_byte_len % required_num_bytes == 0,
                   "Buffer size nust be a multiple of `required_num_bytes`, for following ratchet()->squeeze() to work correctly !");
 
+    // A preceding `generate` call may have left fewer than `required_num_bytes`, but non-zero, readable bytes in the buffer.
+    // Let `generate` stitch the result together from both sides of the ratchet, so that the output stream stays intact.
+    if ((readble_num_bytes != 0) && (readble_num_bytes < required_num_bytes)) {
+      std::array<uint8_t, required_num_bytes> result_bytes{};
+      generate(result_bytes);
+
+      result_type result{};
+      std::memcpy(&result, result_bytes.data(), required_num_bytes);
+
+      return result;
+    }
+
     // When the buffer is exhausted, it's time to ratchet and fill the buffer with new ready-to-use random bytes.
     if (readble_num_bytes == 0) {
+      ensure_not_moved_from();
+
       state.ratchet(xof_selector_t<xof_kind>::ratchet_byte_len);
       state.squeeze(buffer);
       buffer_offset = 0;
@@ -203,7 +484,77 @@ public:
     return result;
   }
 
-  // Squeezes n(>=0) random bytes, instead of getting one at a time, as done by the above functor.
+  /**
+   * Squeezes a random value of type `result_type`, same as the above functor, doing the same work on every call, no matter
+   * where in the buffer the value starts. For code whose timing is audited, see `constant_time.hpp`.
+   *
+   * Unlike the functor, which ratchets only when the buffer runs out, it ratchets a copy of the XOF state and squeezes the
+   * next period into a scratch buffer on every call. Value bytes are then picked from the buffer or the scratch buffer, and
+   * the scratch state is committed or dropped, using masks, without branching. So each call costs a whole ratchet period
+   * worth of squeezing - use it for drawing a few values, whose timing must not tell how many bytes were squeezed before.
+   */
+  [[nodiscard("Internal state of CSPRNG has changed, you should consume this value")]] forceinline result_type next_ct()
+    requires(std::is_trivially_copyable_v<typename xof_selector_t<xof_kind>::type>)
+  {
+    ensure_not_moved_from();
+
+    constexpr size_t required_num_bytes = sizeof(result_type);
+    const size_t readable_num_bytes = buffer.size() - buffer_offset;
+
+    auto next_state = state;
+    std::array<uint8_t, ratchet_period_byte_len> next_buffer{};
+
+    next_state.ratchet(xof_selector_t<xof_kind>::ratchet_byte_len);
+    next_state.squeeze(next_buffer);
+
+    // Byte i of the value is at `buffer_offset + i` in the concatenation of the buffer and the next one.
+    std::array<uint8_t, required_num_bytes> result_bytes{};
+    for (size_t i = 0; i < required_num_bytes; i++) {
+      const size_t pos = buffer_offset + i;
+
+      auto is_in_next_buffer = static_cast<size_t>(pos >= buffer.size());
+      DoNotOptimize(is_in_next_buffer);
+
+      const size_t in_next_buffer_mask = size_t{ 0 } - is_in_next_buffer;
+      const auto byte_mask = static_cast<uint8_t>(in_next_buffer_mask);
+
+      const uint8_t cur_byte = buffer[pos & ~in_next_buffer_mask];
+      const uint8_t next_byte = next_buffer[(pos - buffer.size()) & in_next_buffer_mask];
+
+      result_bytes[i] = static_cast<uint8_t>((cur_byte & ~byte_mask) | (next_byte & byte_mask));
+    }
+
+    // Next state and buffer are committed, only if the value didn't fit in what was left of the buffer.
+    auto needs_refill = static_cast<size_t>(readable_num_bytes < required_num_bytes);
+    DoNotOptimize(needs_refill);
+
+    const size_t refill_mask = size_t{ 0 } - needs_refill;
+    ct_assign(static_cast<uint8_t>(refill_mask), state, next_state);
+    ct_assign(static_cast<uint8_t>(refill_mask), buffer, next_buffer);
+    buffer_offset = buffer_offset + required_num_bytes - (buffer.size() & refill_mask);
+
+    result_type result{};
+    std::memcpy(&result, result_bytes.data(), required_num_bytes);
+
+    next_state.reset();
+    next_buffer.fill(0);
+    result_bytes.fill(0);
+
+    DoNotOptimize(next_state);
+    DoNotOptimize(next_buffer);
+    DoNotOptimize(result_bytes);
+
+    return result;
+  }
+
+  /**
+   * Squeezes n(>=0) random bytes, instead of getting one at a time, as done by the above functor.
+   *
+   * Bytes left in the internal buffer are consumed first. Then, as long as at least `ratchet_period_byte_len` -bytes are
+   * still required, we ratchet and squeeze a whole ratchet period worth of bytes directly into `output`, bypassing the
+   * internal buffer. Only the tail, shorter than a ratchet period, goes through the internal buffer. The output stream
+   * stays exactly the same as if it were squeezed one value at a time, using the above functor.
+   */
   forceinline void generate(std::span<uint8_t> output)
   {
     size_t out_offset = 0;
@@ -211,20 +562,223 @@ public:
     while (out_offset < output.size()) {
       const size_t readable_num_bytes = buffer.size() - buffer_offset;
       const size_t required_num_bytes = output.size() - out_offset;
-      const size_t copyable_num_bytes = std::min(readable_num_bytes, required_num_bytes);
-
-      std::memcpy(&output[out_offset], &buffer[buffer_offset], copyable_num_bytes);
 
-      buffer_offset += copyable_num_bytes;
-      out_offset += copyable_num_bytes;
+      if (readable_num_bytes == 0) {
+        ensure_not_moved_from();
 
-      if (buffer_offset == buffer.size()) {
         state.ratchet(xof_selector_t<xof_kind>::ratchet_byte_len);
+
+        // Internal buffer is exhausted, squeeze whole ratchet period straight into `output`.
+        if (required_num_bytes >= ratchet_period_byte_len) {
+          state.squeeze(output.subspan(out_offset, ratchet_period_byte_len));
+          out_offset += ratchet_period_byte_len;
+
+          continue;
+        }
+
+        // Remaining tail is served from a freshly squeezed internal buffer.
         state.squeeze(buffer);
         buffer_offset = 0;
+
+        continue;
       }
+
+      const size_t copyable_num_bytes = std::min(readable_num_bytes, required_num_bytes);
+      std::memcpy(&output[out_offset], &buffer[buffer_offset], copyable_num_bytes);
+
+      buffer_offset += copyable_num_bytes;
+      out_offset += copyable_num_bytes;
     }
   }
+
+  /**
+   * Mixes `fresh_entropy` into the CSPRNG, without constructing a new instance. A key of `seed_byte_len` -bytes is squeezed
+   * from the underlying XOF instance, which is then re-initialized by absorbing
+   *
+   * DOMAIN || KEY || FRESH_ENTROPY
+   *
+   * So the new state depends on both the old state and the fresh entropy. Bytes left in the internal buffer are discarded,
+   * as they were produced from the old state, which may be shared with another process, say after `fork()`.
+   */
+  forceinline void reseed(std::span<const uint8_t> fresh_entropy)
+  {
+    ensure_not_moved_from();
+
+    std::array<uint8_t, seed_byte_len> key{};
+    state.squeeze(key);
+
+    state.reset();
+    state.absorb(RESEED_DOMAIN);
+    state.absorb(key);
+    state.absorb(fresh_entropy);
+    state.finalize();
+    state.squeeze(buffer);
+    buffer_offset = 0;
+
+    key.fill(0);
+    DoNotOptimize(key);
+  }
+
+  // Samples `seed_byte_len` -bytes of fresh entropy from given entropy source and mixes it into the CSPRNG. See above.
+  template<typename source_t>
+    requires(entropy_source<std::remove_cvref_t<source_t>>)
+  forceinline void reseed(source_t&& source)
+  {
+    std::array<uint8_t, seed_byte_len> fresh_entropy{};
+    source.fill(fresh_entropy);
+
+    reseed(std::span<const uint8_t>(fresh_entropy));
+
+    fresh_entropy.fill(0);
+    DoNotOptimize(fresh_entropy);
+  }
+
+  // Samples `seed_byte_len` -bytes of fresh entropy from the default entropy source and mixes it into the CSPRNG. See above.
+  forceinline void reseed() { reseed(default_entropy_source_t{}); }
+
+  /**
+   * Exports state of the CSPRNG into `output`, returning the number of bytes written, which is at most
+   * `exported_state_max_byte_len`. Exported state is laid out as
+   *
+   * MAGIC || VERSION || XOF_KIND || LE16(RATCHET_PERIOD_BLOCK_COUNT) || LE16(SQUEEZE_OFFSET) || LE32(UNREAD_LEN) ||
+   * LE64(LANE[0]) || ... || LE64(LANE[24]) || UNREAD_BUFFERED_BYTES || CHECKSUM
+   *
+   * where lanes are the Keccak-p[1600] permutation state of the underlying sponge, SQUEEZE_OFFSET is the number of bytes
+   * already squeezed out of its current rate block and CHECKSUM is computed by the same XOF, as described in `checksum`.
+   * Only not yet consumed bytes of the internal buffer are exported, so previously produced output can't be recovered
+   * from it. Importing it into another instance continues the output stream exactly from where it was exported, without
+   * replaying it from the seed. State of the CSPRNG is not modified.
+   *
+   * Anyone holding the exported state can predict all future output, so treat it as secret as the seed and zeroize it
+   * once done.
+   */
+  [[nodiscard]] forceinline size_t export_state(std::span<uint8_t, exported_state_max_byte_len> output) const
+  {
+    check_state_is_exportable();
+    ensure_not_moved_from();
+
+    const auto xof_kind_byte = static_cast<uint8_t>(xof_kind);
+    const auto period_block_count = static_cast<uint16_t>(ratchet_period_block_count);
+    const auto unread_byte_len = static_cast<uint32_t>(buffer.size() - buffer_offset);
+
+    // Every squeeze is a multiple of the rate, so that the sponge is always left in between two rate blocks. Its lanes hold
+    // either the last squeezed block, whose end it is at, or the next block, when the XOF permutes as soon as a block is out.
+    constexpr bool permutes_eagerly = xof_permutes_eagerly<typename xof_selector_t<xof_kind>::type, rate_byte_len>();
+    const auto squeeze_offset = static_cast<uint16_t>(permutes_eagerly ? 0 : rate_byte_len);
+
+    size_t out_offset = 0;
+    const auto write = [&](const void* src, const size_t len) {
+      std::memcpy(output.subspan(out_offset, len).data(), src, len);
+      out_offset += len;
+    };
+
+    write(EXPORTED_STATE_MAGIC.data(), EXPORTED_STATE_MAGIC.size());
+    write(&EXPORTED_STATE_FORMAT_VERSION, sizeof(EXPORTED_STATE_FORMAT_VERSION));
+    write(&xof_kind_byte, sizeof(xof_kind_byte));
+    write(&period_block_count, sizeof(period_block_count));
+    write(&squeeze_offset, sizeof(squeeze_offset));
+    write(&unread_byte_len, sizeof(unread_byte_len));
+    write(&state, EXPORTED_KECCAK_STATE_BYTE_LEN);
+    write(std::span(buffer).subspan(buffer_offset).data(), unread_byte_len);
+
+    checksum(output.first(out_offset), output.subspan(out_offset).template first<EXPORTED_STATE_CHECKSUM_BYTE_LEN>());
+    return out_offset + EXPORTED_STATE_CHECKSUM_BYTE_LEN;
+  }
+
+  /**
+   * Imports state of the CSPRNG, previously exported using `export_state`, replacing current state. Returns false, leaving
+   * current state untouched, if `input` is not a well-formed exported state of the same format version, XOF kind and ratchet
+   * period, if its squeeze offset is beyond the rate or if its checksum doesn't match.
+   *
+   * Only the lanes are taken from `input`, while the sponge is brought to the imported squeeze offset by squeezing from a
+   * freshly finalized instance, so that its internal bookkeeping is never taken from untrusted input.
+   */
+  [[nodiscard]] forceinline bool import_state(std::span<const uint8_t> input)
+  {
+    check_state_is_exportable();
+
+    constexpr size_t min_byte_len = EXPORTED_STATE_HEADER_BYTE_LEN + EXPORTED_KECCAK_STATE_BYTE_LEN + EXPORTED_STATE_CHECKSUM_BYTE_LEN;
+    if (input.size() < min_byte_len) {
+      return false;
+    }
+
+    constexpr size_t fields_offset = EXPORTED_STATE_MAGIC.size() + 2;
+
+    uint16_t period_block_count = 0;
+    uint16_t squeeze_offset = 0;
+    uint32_t unread_byte_len = 0;
+    std::memcpy(&period_block_count, input.subspan(fields_offset, sizeof(uint16_t)).data(), sizeof(uint16_t));
+    std::memcpy(&squeeze_offset, input.subspan(fields_offset + sizeof(uint16_t), sizeof(uint16_t)).data(), sizeof(uint16_t));
+    std::memcpy(&unread_byte_len, input.subspan(fields_offset + 2 * sizeof(uint16_t), sizeof(uint32_t)).data(), sizeof(uint32_t));
+
+    const bool is_well_formed = std::ranges::equal(input.first(EXPORTED_STATE_MAGIC.size()), EXPORTED_STATE_MAGIC) &&
+                                (input[EXPORTED_STATE_MAGIC.size()] == EXPORTED_STATE_FORMAT_VERSION) &&
+                                (input[EXPORTED_STATE_MAGIC.size() + 1] == static_cast<uint8_t>(xof_kind)) &&
+                                (period_block_count == ratchet_period_block_count) && (squeeze_offset <= rate_byte_len) &&
+                                (unread_byte_len <= buffer.size()) && (input.size() == min_byte_len + unread_byte_len);
+    if (!is_well_formed) {
+      return false;
+    }
+
+    const auto checksummed = input.first(input.size() - EXPORTED_STATE_CHECKSUM_BYTE_LEN);
+
+    std::array<uint8_t, EXPORTED_STATE_CHECKSUM_BYTE_LEN> expected_checksum{};
+    checksum(checksummed, expected_checksum);
+
+    uint8_t checksum_diff = 0;
+    for (size_t i = 0; i < expected_checksum.size(); i++) {
+      checksum_diff |= static_cast<uint8_t>(expected_checksum[i] ^ input[checksummed.size() + i]);
+    }
+    if (checksum_diff != 0) {
+      return false;
+    }
+
+    // A finalized sponge, with its lanes replaced by the imported ones, and then squeezed up to the imported squeeze offset.
+    typename xof_selector_t<xof_kind>::type imported_state{};
+    imported_state.reset();
+    imported_state.finalize();
+
+    auto object_repr = std::bit_cast<std::array<uint8_t, sizeof(imported_state)>>(imported_state);
+    std::memcpy(object_repr.data(), input.subspan(EXPORTED_STATE_HEADER_BYTE_LEN, EXPORTED_KECCAK_STATE_BYTE_LEN).data(), EXPORTED_KECCAK_STATE_BYTE_LEN);
+    imported_state = std::bit_cast<decltype(imported_state)>(object_repr);
+
+    std::array<uint8_t, rate_byte_len> skipped{};
+    imported_state.squeeze(std::span(skipped).first(squeeze_offset));
+
+    state = imported_state;
+    is_moved_from = false;
+
+    // Unread bytes are placed at the end of the internal buffer, while the consumed part is zeroized.
+    buffer_offset = buffer.size() - unread_byte_len;
+    std::fill_n(buffer.begin(), buffer_offset, uint8_t{ 0 });
+    std::memcpy(std::span(buffer).subspan(buffer_offset).data(),
+                input.subspan(EXPORTED_STATE_HEADER_BYTE_LEN + EXPORTED_KECCAK_STATE_BYTE_LEN, unread_byte_len).data(),
+                unread_byte_len);
+
+    imported_state.reset();
+    DoNotOptimize(imported_state);
+
+    object_repr.fill(0);
+    DoNotOptimize(object_repr);
+
+    skipped.fill(0);
+    DoNotOptimize(skipped);
+
+    return true;
+  }
+
+  /**
+   * Fills `output` with random unsigned integers of type `T`, which doesn't need to be same as `result_type`, squeezing
+   * all of them at once. Produces exactly the same values as if `output.size_bytes()` -many bytes were squeezed using
+   * above `generate`, and reinterpreted as little-endian `T` values. Hence scalar and batched calls can be interleaved,
+   * without affecting the output stream.
+   */
+  template<typename T>
+    requires(std::is_unsigned_v<T> && !std::is_same_v<T, uint8_t> && !std::is_same_v<T, bool>)
+  forceinline void generate(std::span<T> output)
+  {
+    generate(std::span<uint8_t>(reinterpret_cast<uint8_t*>(output.data()), output.size_bytes())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
 };
 
 }
@@ -0,0 +1,289 @@
+#pragma once
+#include "randomshake/keccak_multistate.hpp"
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace randomshake {
+
+/**
+ * Batch RandomSHAKE - advances `num_instances`-many independently seeded RandomSHAKE CSPRNG instances together, say one per
+ * live session, with output of instance i being exactly the same as the output of a `randomshake_t`, seeded with seed i.
+ *
+ * Meant for servers keeping one CSPRNG per live session. All instances live in a single object, indexed by session, instead of
+ * as many separately allocated `randomshake_t` instances. `generate_all` serves the next few bytes of every instance, say a
+ * nonce per session, in one call.
+ *
+ * Keccak-p[1600] states of all instances are kept in lane-major layout, lane j of every instance next to each other, so that
+ * they are permuted side-by-side, in SIMD registers. See `keccak_multistate.hpp`. When an instance runs out of buffered bytes,
+ * every instance which has run out is ratcheted and refilled, up to 8 of them at once, in one interleaved permutation per
+ * rate block. Instances with buffered bytes left are untouched.
+ *
+ * An instance holds ~1.3KB, with the default ratchet period, so allocate large batches on the heap.
+ */
+template<size_t num_instances,
+         typename UIntType = uint8_t,
+         xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256,
+         size_t ratchet_period_block_count = default_ratchet_period_block_count<xof_kind>>
+  requires(std::is_unsigned_v<UIntType> && check_endianness() && (num_instances > 0) && (ratchet_period_block_count > 0) &&
+           (ratchet_period_block_count <= std::numeric_limits<uint16_t>::max()))
+struct randomshake_batch_t
+{
+public:
+  using result_type = UIntType;
+
+  static constexpr auto instance_count = num_instances;
+  static constexpr auto seed_byte_len = xof_selector_t<xof_kind>::seed_byte_len;
+  static constexpr auto ratchet_period_byte_len = randomshake_t<UIntType, xof_kind, ratchet_period_block_count>::ratchet_period_byte_len;
+  static constexpr auto min = std::numeric_limits<result_type>::min;
+  static constexpr auto max = std::numeric_limits<result_type>::max;
+
+private:
+  using sponges_t = multistate_sponge_t<xof_kind, num_instances>;
+  static constexpr size_t rate_byte_len = sponges_t::rate_byte_len;
+
+  // Number of exhausted instances, which are ratcheted and refilled together, in one interleaved permutation per rate block.
+  static constexpr size_t refill_group_size = std::min<size_t>(num_instances, 8);
+  using refill_group_sponges_t = multistate_sponge_t<xof_kind, refill_group_size>;
+
+  static_assert(seed_byte_len == rate_byte_len, "Seed must fill exactly one rate block, for it to be absorbed into all instances at once !");
+
+  sponges_t sponges{};
+  std::array<std::array<uint8_t, ratchet_period_byte_len>, num_instances> buffers{};
+  std::array<size_t, num_instances> buffer_offsets{};
+
+  // Absorbs `seed` into XOF state of instance `instance_idx`. All seeded instances are finalized together, by `squeeze_first`.
+  forceinline constexpr void seed_instance(const size_t instance_idx, std::span<const uint8_t, seed_byte_len> seed)
+  {
+    sponges.absorb_block(instance_idx, seed);
+  }
+
+  // Finalizes all seeded instances and fills their buffers with first batch of random bytes.
+  forceinline constexpr void squeeze_first()
+  {
+    // Seed fills the whole first block, so padding goes into the second, otherwise empty, block.
+    sponges.permute();
+    for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+      sponges.pad(instance_idx, 0);
+    }
+    sponges.finalize();
+
+    for (size_t block_offset = 0; block_offset < ratchet_period_byte_len; block_offset += rate_byte_len) {
+      sponges.squeeze_block([&](const size_t instance_idx) { return std::span(buffers[instance_idx]).subspan(block_offset).template first<rate_byte_len>(); });
+    }
+
+    buffer_offsets.fill(0);
+  }
+
+  /**
+   * Ratchets the first `group_len` -many instances, listed in `group`, and squeezes a whole ratchet period into their buffers.
+   * Their states are gathered into a group of sponges, permuted side-by-side, and then scattered back. Rate blocks squeezed
+   * from unused sponges of the group are written into a scratch block and dropped.
+   */
+  forceinline void refill_group(std::span<const size_t, refill_group_size> group, const size_t group_len)
+  {
+    refill_group_sponges_t group_sponges{};
+    for (size_t lane_idx = 0; lane_idx < group_sponges.lanes.size(); lane_idx++) {
+      for (size_t slot_idx = 0; slot_idx < group_len; slot_idx++) {
+        group_sponges.lanes[lane_idx][slot_idx] = sponges.lanes[lane_idx][group[slot_idx]];
+      }
+    }
+
+    // All instances are in between two whole rate blocks, just like `sponges`, since each of them squeezes whole periods.
+    group_sponges.is_block_squeezed = sponges.is_block_squeezed;
+    group_sponges.ratchet();
+
+    std::array<uint8_t, rate_byte_len> dropped_block{};
+    for (size_t block_offset = 0; block_offset < ratchet_period_byte_len; block_offset += rate_byte_len) {
+      group_sponges.squeeze_block([&](const size_t slot_idx) {
+        if (slot_idx < group_len) {
+          return std::span(buffers[group[slot_idx]]).subspan(block_offset).template first<rate_byte_len>();
+        }
+
+        return std::span<uint8_t, rate_byte_len>(dropped_block);
+      });
+    }
+
+    for (size_t lane_idx = 0; lane_idx < group_sponges.lanes.size(); lane_idx++) {
+      for (size_t slot_idx = 0; slot_idx < group_len; slot_idx++) {
+        sponges.lanes[lane_idx][group[slot_idx]] = group_sponges.lanes[lane_idx][slot_idx];
+      }
+    }
+
+    for (size_t slot_idx = 0; slot_idx < group_len; slot_idx++) {
+      buffer_offsets[group[slot_idx]] = 0;
+    }
+
+    group_sponges.reset();
+    DoNotOptimize(group_sponges);
+
+    dropped_block.fill(0);
+    DoNotOptimize(dropped_block);
+  }
+
+  // Copies as many unread bytes of instance `instance_idx`, as available, into `output`, returning the number of bytes copied.
+  forceinline size_t copy_buffered(const size_t instance_idx, std::span<uint8_t> output)
+  {
+    const size_t copyable_num_bytes = std::min(ratchet_period_byte_len - buffer_offsets[instance_idx], output.size());
+    std::memcpy(output.data(), std::span(buffers[instance_idx]).subspan(buffer_offsets[instance_idx]).data(), copyable_num_bytes);
+
+    buffer_offsets[instance_idx] += copyable_num_bytes;
+    return copyable_num_bytes;
+  }
+
+public:
+  // Samples `seed_byte_len` -many bytes for each instance from the default entropy source and initializes all of them.
+  forceinline randomshake_batch_t()
+    : randomshake_batch_t(default_entropy_source_t{})
+  {
+  }
+
+  /**
+   * Samples `seed_byte_len` -many bytes for each instance from given entropy source and initializes all of them. Seeds are
+   * sampled one instance at a time, into a single seed-sized buffer, so stack usage doesn't grow with `num_instances`.
+   */
+  template<typename source_t>
+    requires(entropy_source<std::remove_cvref_t<source_t>>)
+  forceinline explicit randomshake_batch_t(source_t&& source)
+  {
+    std::array<uint8_t, seed_byte_len> seed{};
+    auto seed_span = std::span(seed);
+
+    sponges.reset();
+    for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+      source.fill(seed_span);
+      seed_instance(instance_idx, seed_span);
+
+      seed.fill(0);
+      DoNotOptimize(seed);
+    }
+
+    squeeze_first();
+  }
+
+  /**
+   * Explicit constructor. Expects user to supply us with `seed_byte_len` -bytes seed for each instance, concatenated, so that
+   * instance i is initialized with `seeds[i * seed_byte_len : (i + 1) * seed_byte_len]`.
+   */
+  forceinline explicit constexpr randomshake_batch_t(std::span<const uint8_t, num_instances * seed_byte_len> seeds)
+  {
+    sponges.reset();
+    for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+      seed_instance(instance_idx, seeds.subspan(instance_idx * seed_byte_len).template first<seed_byte_len>());
+    }
+
+    squeeze_first();
+  }
+
+  // Delete copy and move constructors - as this CSPRNG instance is neither copyable nor movable.
+  randomshake_batch_t(const randomshake_batch_t&) = delete;
+  randomshake_batch_t(randomshake_batch_t&&) = delete;
+  randomshake_batch_t& operator=(const randomshake_batch_t&) = delete;
+  randomshake_batch_t& operator=(randomshake_batch_t&&) = delete;
+
+  // Zeroize internal state when destroying an instance of CSPRNG.
+  ~randomshake_batch_t()
+  {
+    sponges.reset();
+    DoNotOptimize(sponges);
+
+    for (auto& buffer : buffers) {
+      buffer.fill(0);
+    }
+    DoNotOptimize(buffers);
+
+    buffer_offsets.fill(0);
+  }
+
+  // Ratchets and refills every instance which has run out of buffered bytes, `refill_group_size` of them at once. Others are left untouched.
+  forceinline void refill()
+  {
+    std::array<size_t, refill_group_size> group{};
+    size_t group_len = 0;
+
+    for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+      if (buffer_offsets[instance_idx] != ratchet_period_byte_len) {
+        continue;
+      }
+
+      group[group_len++] = instance_idx;
+      if (group_len == refill_group_size) {
+        refill_group(group, group_len);
+        group_len = 0;
+      }
+    }
+
+    if (group_len > 0) {
+      refill_group(group, group_len);
+    }
+  }
+
+  // Squeezes a random value of type `result_type`, from instance `instance_idx`.
+  [[nodiscard("Internal state of CSPRNG has changed, you should consume this value")]] forceinline result_type operator()(const size_t instance_idx)
+  {
+    std::array<uint8_t, sizeof(result_type)> result_bytes{};
+    generate(instance_idx, result_bytes);
+
+    result_type result{};
+    std::memcpy(&result, result_bytes.data(), result_bytes.size());
+
+    return result;
+  }
+
+  // Squeezes n(>=0) random bytes from instance `instance_idx`. Whenever it runs out of buffered bytes, see `refill`.
+  forceinline void generate(const size_t instance_idx, std::span<uint8_t> output)
+  {
+    size_t out_offset = 0;
+
+    while (true) {
+      out_offset += copy_buffered(instance_idx, output.subspan(out_offset));
+      if (out_offset == output.size()) {
+        break;
+      }
+
+      refill();
+    }
+  }
+
+  /**
+   * Splits `output` into `num_instances` -many consecutive chunks and fills chunk i with the next random bytes of instance i,
+   * say a nonce for each session. When `output.size()` is a multiple of `num_instances`, chunks are of equal length. Otherwise,
+   * each of the first `output.size() % num_instances` chunks is one byte longer than the rest, so every byte of `output` is filled.
+   */
+  forceinline void generate_all(std::span<uint8_t> output)
+  {
+    const size_t chunk_byte_len = output.size() / num_instances;
+    const size_t num_longer_chunks = output.size() % num_instances;
+
+    const auto chunk_of = [&](const size_t instance_idx) {
+      const size_t chunk_begin = instance_idx * chunk_byte_len + std::min(instance_idx, num_longer_chunks);
+      return output.subspan(chunk_begin, chunk_byte_len + static_cast<size_t>(instance_idx < num_longer_chunks));
+    };
+
+    std::array<size_t, num_instances> chunk_offsets{};
+
+    while (true) {
+      bool has_pending_bytes = false;
+
+      for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+        const auto chunk = chunk_of(instance_idx);
+
+        chunk_offsets[instance_idx] += copy_buffered(instance_idx, chunk.subspan(chunk_offsets[instance_idx]));
+        has_pending_bytes |= (chunk_offsets[instance_idx] != chunk.size());
+      }
+
+      if (!has_pending_bytes) {
+        break;
+      }
+
+      refill();
+    }
+  }
+};
+
+}
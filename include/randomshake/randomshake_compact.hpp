@@ -0,0 +1,203 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace randomshake {
+
+/**
+ * Compact RandomSHAKE - a low-footprint variant of RandomSHAKE CSPRNG, for when you hold very many instances at once, say one
+ * per live session.
+ *
+ * Instead of squeezing a whole ratchet period worth of bytes into an internal buffer, random bytes are squeezed straight out of
+ * the rate part of the underlying XOF's state, only when asked for. So an instance is just the XOF state and a counter of bytes
+ * squeezed since the last ratchet. Finalization of the XOF, after absorbing the seed, is deferred until the first use, so an
+ * instance which is never used doesn't pay for it.
+ *
+ * Ratchets exactly when `randomshake_t` does, so it produces the same output stream, for the same seed, XOF kind and ratchet
+ * period. It trades some throughput, for small values, as every call squeezes from the XOF, instead of copying from a buffer.
+ * It supports neither reseeding nor state export.
+ */
+template<typename UIntType = uint8_t,
+         xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256,
+         size_t ratchet_period_block_count = default_ratchet_period_block_count<xof_kind>>
+  requires(std::is_unsigned_v<UIntType> && check_endianness() && (ratchet_period_block_count > 0) &&
+           (ratchet_period_block_count <= std::numeric_limits<uint16_t>::max()))
+struct randomshake_compact_t
+{
+public:
+  using result_type = UIntType;
+
+  static constexpr auto seed_byte_len = xof_selector_t<xof_kind>::seed_byte_len;
+  static constexpr auto ratchet_period_byte_len = randomshake_t<UIntType, xof_kind, ratchet_period_block_count>::ratchet_period_byte_len;
+  static constexpr auto min = std::numeric_limits<result_type>::min;
+  static constexpr auto max = std::numeric_limits<result_type>::max;
+
+private:
+  // Marks an XOF state, which has absorbed the seed, but is not yet finalized.
+  static constexpr size_t NOT_FINALIZED = std::numeric_limits<size_t>::max();
+
+  // Marks the instance whose XOF state has been moved out, as it no longer has any secret state to produce output from.
+  static constexpr size_t MOVED_FROM = NOT_FINALIZED - 1;
+
+  xof_selector_t<xof_kind>::type state{};
+  size_t period_offset = NOT_FINALIZED;
+
+  // Zeroizes XOF state, so that no output can be recovered from this instance.
+  forceinline void zeroize()
+  {
+    state.reset();
+    DoNotOptimize(state);
+
+    period_offset = 0;
+  }
+
+  // Zeroizes the instance whose XOF state has been moved out, marking it so that any use of it fails loudly.
+  forceinline void mark_moved_from()
+  {
+    zeroize();
+    period_offset = MOVED_FROM;
+  }
+
+  // Aborts the process, if this instance has been moved from, instead of producing a predictable output stream from zeroized state.
+  forceinline void ensure_not_moved_from() const
+  {
+    if (period_offset == MOVED_FROM) [[unlikely]] {
+      std::abort();
+    }
+  }
+
+public:
+  // Samples `seed_byte_len` -many bytes from the default entropy source and absorbs them into the chosen XOF.
+  forceinline randomshake_compact_t()
+    : randomshake_compact_t(default_entropy_source_t{})
+  {
+  }
+
+  // Samples `seed_byte_len` -many bytes from given entropy source and absorbs them into the chosen XOF.
+  template<typename source_t>
+    requires(entropy_source<std::remove_cvref_t<source_t>>)
+  forceinline explicit randomshake_compact_t(source_t&& source)
+  {
+    std::array<uint8_t, seed_byte_len> seed{};
+    auto seed_span = std::span(seed);
+
+    source.fill(seed_span);
+
+    state.reset();
+    state.absorb(seed_span);
+
+    seed.fill(0);
+    DoNotOptimize(seed);
+  }
+
+  /**
+   * Explicit constructor. Expects user to supply us with `seed_byte_len` -bytes seed, which is absorbed into the chosen XOF.
+   * It is user's responsibility to ensure that the supplied seed has sufficient entropy.
+   */
+  forceinline explicit constexpr randomshake_compact_t(std::span<const uint8_t, seed_byte_len> seed)
+  {
+    state.reset();
+    state.absorb(seed);
+  }
+
+  /**
+   * Takes over an XOF state, which has absorbed the seed, and possibly more, but is not yet finalized. Lets a cached XOF state,
+   * which has absorbed a long common prefix, be forked into many CSPRNG instances. See `randomshake_substreams_t`.
+   */
+  forceinline explicit constexpr randomshake_compact_t(const xof_selector_t<xof_kind>::type& absorbed_state)
+    : state(absorbed_state)
+  {
+  }
+
+  // Delete copy constructor and copy assignment - as this CSPRNG instance must never be cloned, producing the same output stream twice.
+  randomshake_compact_t(const randomshake_compact_t&) = delete;
+  randomshake_compact_t& operator=(const randomshake_compact_t&) = delete;
+
+  /**
+   * Moves XOF state into a new instance and zeroizes `other`, which must then only be destroyed or assigned to. Squeezing from
+   * a moved-from instance aborts the process.
+   */
+  forceinline randomshake_compact_t(randomshake_compact_t&& other) noexcept
+    : state(other.state)
+    , period_offset(other.period_offset)
+  {
+    other.mark_moved_from();
+  }
+
+  // Zeroizes XOF state of this instance, before taking over XOF state of `other`, which is then zeroized.
+  forceinline randomshake_compact_t& operator=(randomshake_compact_t&& other) noexcept
+  {
+    if (this != &other) {
+      zeroize();
+
+      state = other.state;
+      period_offset = other.period_offset;
+
+      other.mark_moved_from();
+    }
+
+    return *this;
+  }
+
+  // Zeroize internal state when destroying an instance of CSPRNG.
+  ~randomshake_compact_t() { zeroize(); }
+
+  // Squeezes a random value of type `result_type`.
+  [[nodiscard("Internal state of CSPRNG has changed, you should consume this value")]] forceinline result_type operator()()
+  {
+    std::array<uint8_t, sizeof(result_type)> result_bytes{};
+    generate(result_bytes);
+
+    result_type result{};
+    std::memcpy(&result, result_bytes.data(), result_bytes.size());
+
+    return result;
+  }
+
+  /**
+   * Squeezes n(>=0) random bytes, straight from the XOF into `output`. Ratchets before squeezing any byte past the end of the
+   * current ratchet period, just like `randomshake_t` does, when its internal buffer is exhausted.
+   */
+  forceinline void generate(std::span<uint8_t> output)
+  {
+    // Both markers lie beyond any offset within a ratchet period, so the common path takes a single branch.
+    if (period_offset > ratchet_period_byte_len) [[unlikely]] {
+      ensure_not_moved_from();
+
+      state.finalize();
+      period_offset = 0;
+    }
+
+    size_t out_offset = 0;
+
+    while (out_offset < output.size()) {
+      if (period_offset == ratchet_period_byte_len) {
+        state.ratchet(xof_selector_t<xof_kind>::ratchet_byte_len);
+        period_offset = 0;
+      }
+
+      const size_t squeezable_num_bytes = std::min(ratchet_period_byte_len - period_offset, output.size() - out_offset);
+      state.squeeze(output.subspan(out_offset, squeezable_num_bytes));
+
+      period_offset += squeezable_num_bytes;
+      out_offset += squeezable_num_bytes;
+    }
+  }
+
+  // Fills a span of wider unsigned integers, with little-endian interpretation of squeezed bytes. See above.
+  template<typename T>
+    requires(std::is_unsigned_v<T> && !std::is_same_v<T, uint8_t> && !std::is_same_v<T, bool>)
+  forceinline void generate(std::span<T> output)
+  {
+    generate(std::span<uint8_t>(reinterpret_cast<uint8_t*>(output.data()), output.size_bytes())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+};
+
+}
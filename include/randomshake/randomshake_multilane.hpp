@@ -0,0 +1,223 @@
+#pragma once
+#include "randomshake/keccak_multistate.hpp"
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace randomshake {
+
+/**
+ * Multi-lane RandomSHAKE - runs `num_lanes`-many independently seeded sponges of the chosen XOF side-by-side, interleaved in
+ * SIMD registers, and stitches their ratcheted output into a single pseudo-random byte stream.
+ *
+ * Lane i is initialized by absorbing the common seed, followed by a single byte holding i, so that no two lanes ever produce
+ * the same byte stream. Every permutation runs on all lanes at once, 8 of them side-by-side on AVX-512, 4 on AVX2, 2 elsewhere,
+ * picked at run-time. See `keccak_multistate.hpp`. Every `ratchet_period_block_count` rate blocks, all lanes are ratcheted,
+ * just like `randomshake_t` ratchets its sponge. Output stream is formed by concatenating a ratchet period worth of bytes
+ * squeezed from lane 0, then lane 1, ..., then lane `num_lanes - 1`, before moving on to the next ratchet period.
+ *
+ * Note, output stream of this CSPRNG is different from the output stream of `randomshake_t`, for the same seed. On CPUs with
+ * neither AVX2 nor AVX-512, it is no faster than `randomshake_t`.
+ */
+template<typename UIntType = uint8_t,
+         xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256,
+         size_t num_lanes = 4,
+         size_t ratchet_period_block_count = default_ratchet_period_block_count<xof_kind>>
+  requires(std::is_unsigned_v<UIntType> && check_endianness() && (num_lanes > 1) && (num_lanes <= std::numeric_limits<uint8_t>::max() + 1) &&
+           (ratchet_period_block_count > 0))
+struct randomshake_multilane_t
+{
+public:
+  using result_type = UIntType;
+
+  static constexpr auto seed_byte_len = xof_selector_t<xof_kind>::seed_byte_len;
+  static constexpr auto lane_count = num_lanes;
+  static constexpr auto min = std::numeric_limits<result_type>::min;
+  static constexpr auto max = std::numeric_limits<result_type>::max;
+
+  // Everytime these many bytes are squeezed from each lane, all of them are ratcheted.
+  static constexpr size_t lane_period_byte_len = ratchet_period_block_count * (xof_selector_t<xof_kind>::rate / std::numeric_limits<uint8_t>::digits);
+
+  // Output stream advances by these many bytes, between two consecutive ratchets.
+  static constexpr size_t ratchet_period_byte_len = num_lanes * lane_period_byte_len;
+
+private:
+  using sponge_t = multistate_sponge_t<xof_kind, num_lanes>;
+  static constexpr size_t rate_byte_len = sponge_t::rate_byte_len;
+
+  static_assert(seed_byte_len == rate_byte_len, "Seed must fill exactly one rate block, for it to be absorbed into all lanes at once !");
+
+  sponge_t sponge{};
+  std::array<uint8_t, ratchet_period_byte_len> buffer{};
+  size_t buffer_offset = 0U;
+
+  // Absorbs seed and lane index into each lane and finalizes them.
+  forceinline constexpr void init(std::span<const uint8_t, seed_byte_len> seed)
+  {
+    sponge.reset();
+
+    for (size_t lane_idx = 0; lane_idx < num_lanes; lane_idx++) {
+      sponge.absorb_block(lane_idx, seed);
+    }
+    sponge.permute();
+
+    for (size_t lane_idx = 0; lane_idx < num_lanes; lane_idx++) {
+      const std::array<uint8_t, 1> lane_idx_byte{ static_cast<uint8_t>(lane_idx) };
+
+      sponge.absorb_block(lane_idx, lane_idx_byte);
+      sponge.pad(lane_idx, lane_idx_byte.size());
+    }
+    sponge.finalize();
+  }
+
+  // Squeezes a ratchet period worth of bytes from each lane into `output`, lane after lane, one permutation per rate block.
+  forceinline constexpr void squeeze_period(std::span<uint8_t, ratchet_period_byte_len> output)
+  {
+    for (size_t block_offset = 0; block_offset < lane_period_byte_len; block_offset += rate_byte_len) {
+      const auto lane_block = [&](const size_t lane_idx) {
+        return output.subspan(lane_idx * lane_period_byte_len + block_offset).template first<rate_byte_len>();
+      };
+      sponge.squeeze_block(lane_block);
+    }
+  }
+
+public:
+  // Samples `seed_byte_len` -many bytes from the default entropy source and initializes all lanes - making it ready for use.
+  forceinline randomshake_multilane_t()
+    : randomshake_multilane_t(default_entropy_source_t{})
+  {
+  }
+
+  // Samples `seed_byte_len` -many bytes from given entropy source and initializes all lanes. See `entropy_source.hpp`.
+  template<typename source_t>
+    requires(entropy_source<std::remove_cvref_t<source_t>>)
+  forceinline explicit randomshake_multilane_t(source_t&& source)
+  {
+    std::array<uint8_t, seed_byte_len> seed{};
+    auto seed_span = std::span(seed);
+
+    source.fill(seed_span);
+    init(seed_span);
+    squeeze_period(buffer);
+
+    seed.fill(0);
+    DoNotOptimize(seed);
+  }
+
+  // Explicit constructor. Expects user to supply us with `seed_byte_len` -bytes seed, which is used for initializing all lanes.
+  forceinline explicit constexpr randomshake_multilane_t(std::span<const uint8_t, seed_byte_len> seed)
+  {
+    init(seed);
+    squeeze_period(buffer);
+  }
+
+  // Delete copy and move constructors - as this CSPRNG instance is neither copyable nor movable.
+  randomshake_multilane_t(const randomshake_multilane_t&) = delete;
+  randomshake_multilane_t(randomshake_multilane_t&&) = delete;
+  randomshake_multilane_t& operator=(const randomshake_multilane_t&) = delete;
+  randomshake_multilane_t& operator=(randomshake_multilane_t&&) = delete;
+
+  // Zeroize internal state when destroying an instance of CSPRNG.
+  ~randomshake_multilane_t()
+  {
+    sponge.reset();
+    DoNotOptimize(sponge);
+
+    buffer.fill(0);
+    DoNotOptimize(buffer);
+
+    buffer_offset = 0;
+  }
+
+  // Squeezes a random value of type `result_type`.
+  [[nodiscard("Internal state of CSPRNG has changed, you should consume this value")]] forceinline result_type operator()()
+  {
+    constexpr size_t required_num_bytes = sizeof(result_type);
+    const size_t readble_num_bytes = buffer.size() - buffer_offset;
+
+    static_assert(lane_period_byte_len % required_num_bytes == 0,
+                  "Buffer size nust be a multiple of `required_num_bytes`, for following ratchet()->squeeze() to work correctly !");
+
+    // A preceding `generate` call may have left fewer than `required_num_bytes`, but non-zero, readable bytes in the buffer.
+    if ((readble_num_bytes != 0) && (readble_num_bytes < required_num_bytes)) {
+      std::array<uint8_t, required_num_bytes> result_bytes{};
+      generate(result_bytes);
+
+      result_type result{};
+      std::memcpy(&result, result_bytes.data(), required_num_bytes);
+
+      return result;
+    }
+
+    if (readble_num_bytes == 0) {
+      sponge.ratchet();
+      squeeze_period(buffer);
+      buffer_offset = 0;
+    }
+
+    result_type result{};
+    std::memcpy(&result, &buffer[buffer_offset], required_num_bytes);
+    buffer_offset += required_num_bytes;
+
+    return result;
+  }
+
+  /**
+   * Squeezes n(>=0) random bytes, instead of getting one at a time, as done by the above functor. Just like `randomshake_t`,
+   * whole ratchet periods are squeezed straight into `output`, while only the tail goes through the internal buffer.
+   */
+  forceinline void generate(std::span<uint8_t> output)
+  {
+    size_t out_offset = 0;
+
+    while (out_offset < output.size()) {
+      const size_t readable_num_bytes = buffer.size() - buffer_offset;
+      const size_t required_num_bytes = output.size() - out_offset;
+
+      if (readable_num_bytes == 0) {
+        sponge.ratchet();
+
+        if (required_num_bytes >= ratchet_period_byte_len) {
+          squeeze_period(output.subspan(out_offset).template first<ratchet_period_byte_len>());
+          out_offset += ratchet_period_byte_len;
+
+          continue;
+        }
+
+        squeeze_period(buffer);
+        buffer_offset = 0;
+
+        continue;
+      }
+
+      const size_t copyable_num_bytes = std::min(readable_num_bytes, required_num_bytes);
+      std::memcpy(&output[out_offset], &buffer[buffer_offset], copyable_num_bytes);
+
+      buffer_offset += copyable_num_bytes;
+      out_offset += copyable_num_bytes;
+    }
+  }
+
+  // Fills `output` with random unsigned integers of type `T`, producing the same values as squeezing their bytes would.
+  template<typename T>
+    requires(std::is_unsigned_v<T> && !std::is_same_v<T, uint8_t> && !std::is_same_v<T, bool>)
+  forceinline void generate(std::span<T> output)
+  {
+    generate(std::span<uint8_t>(reinterpret_cast<uint8_t*>(output.data()), output.size_bytes())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+};
+
+// Four-lane RandomSHAKE CSPRNG, filling AVX2 registers.
+template<typename UIntType = uint8_t, xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256>
+using randomshake_x4_t = randomshake_multilane_t<UIntType, xof_kind, 4>;
+
+// Eight-lane RandomSHAKE CSPRNG, filling AVX-512 registers.
+template<typename UIntType = uint8_t, xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256>
+using randomshake_x8_t = randomshake_multilane_t<UIntType, xof_kind, 8>;
+
+}
@@ -0,0 +1,247 @@
+#pragma once
+#include "randomshake/entropy_source.hpp"
+#include "randomshake/randomshake.hpp"
+#include "randomshake/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace randomshake {
+
+// How a `randomshake_prefetching_t` instance refills the slots of its ring buffer, which have been consumed.
+enum class refill_mode_t : uint8_t
+{
+  BACKGROUND_THREAD, // A dedicated worker thread refills slots, as soon as they are consumed.
+  MANUAL,            // Slots are refilled only by calling `refill()`, say when the application is idle.
+};
+
+/**
+ * Prefetching RandomSHAKE - keeps a ring buffer of `num_slots`-many slots, each holding one ratchet period worth of bytes,
+ * pre-squeezed from a `randomshake_t` instance, so that squeezing random values usually boils down to a memcpy, without ever
+ * stalling for ratcheting and permutation of the underlying XOF.
+ *
+ * Slots are refilled either by a background worker thread or by explicitly calling `refill()`, see `refill_mode_t`. Only when
+ * all slots are consumed, the caller stalls - waiting for the worker thread to refill a slot, or refilling one itself, in
+ * manual mode. Slots are consumed in the same order they were filled, so the output stream is same as the output stream of
+ * `randomshake_t`, for the same seed.
+ *
+ * Only a single thread may squeeze from an instance at a time. In manual mode, `refill()` must also be called from that thread
+ * or be externally synchronized with it.
+ *
+ * Underlying `randomshake_t` ratchets every `ratchet_period_block_count` rate blocks, which is also the size of a slot.
+ */
+template<typename UIntType = uint8_t,
+         xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256,
+         size_t num_slots = 4,
+         size_t ratchet_period_block_count = default_ratchet_period_block_count<xof_kind>>
+  requires(std::is_unsigned_v<UIntType> && (num_slots > 1))
+struct randomshake_prefetching_t
+{
+public:
+  using csprng_t = randomshake_t<uint8_t, xof_kind, ratchet_period_block_count>;
+  static constexpr size_t slot_byte_len = csprng_t::ratchet_period_byte_len;
+
+private:
+  // Keeps counters, which are written by different threads, on separate cache lines, avoiding false sharing.
+  static constexpr size_t cache_line_byte_len = 64;
+
+  csprng_t csprng;
+  std::array<std::array<uint8_t, slot_byte_len>, num_slots> slots{};
+
+  alignas(cache_line_byte_len) std::atomic<uint64_t> num_filled_slots{ 0 };
+  alignas(cache_line_byte_len) std::atomic<uint64_t> num_consumed_slots{ 0 };
+  size_t slot_offset = 0U;
+
+  refill_mode_t mode;
+  std::atomic<bool> stop_requested{ false };
+  std::jthread worker{};
+
+  // Fills the slot following the last filled one. Must only be called when there is at least one free slot.
+  forceinline void fill_next_slot()
+  {
+    const uint64_t filled = num_filled_slots.load(std::memory_order_relaxed);
+
+    csprng.generate(slots[filled % num_slots]);
+    num_filled_slots.store(filled + 1, std::memory_order_release);
+    num_filled_slots.notify_one();
+  }
+
+  // Body of the background worker thread, which keeps all slots filled, sleeping while there is no free slot.
+  void refill_forever()
+  {
+    while (!stop_requested.load(std::memory_order_acquire)) {
+      const uint64_t consumed = num_consumed_slots.load(std::memory_order_acquire);
+
+      if (num_filled_slots.load(std::memory_order_relaxed) < consumed + num_slots) {
+        fill_next_slot();
+        continue;
+      }
+
+      num_consumed_slots.wait(consumed, std::memory_order_acquire);
+    }
+  }
+
+  // Blocks until a filled slot is available to be consumed, refilling one in the calling thread, in manual mode.
+  forceinline void wait_for_filled_slot()
+  {
+    const uint64_t consumed = num_consumed_slots.load(std::memory_order_relaxed);
+
+    if (mode == refill_mode_t::MANUAL) {
+      fill_next_slot();
+      return;
+    }
+
+    num_filled_slots.wait(consumed, std::memory_order_acquire);
+  }
+
+  /**
+   * Fills `output` with bytes from filled slots, in order, releasing each slot to the refiller, as soon as it is consumed.
+   * A consumed slot is zeroized before release, so that past output doesn't linger in it until it is refilled.
+   */
+  forceinline void read(std::span<uint8_t> output)
+  {
+    size_t out_offset = 0;
+
+    while (out_offset < output.size()) {
+      const uint64_t consumed = num_consumed_slots.load(std::memory_order_relaxed);
+      if (num_filled_slots.load(std::memory_order_acquire) == consumed) [[unlikely]] {
+        wait_for_filled_slot();
+        continue;
+      }
+
+      auto& slot = slots[consumed % num_slots];
+      const size_t copyable_num_bytes = std::min(slot_byte_len - slot_offset, output.size() - out_offset);
+
+      std::memcpy(output.subspan(out_offset, copyable_num_bytes).data(), &slot[slot_offset], copyable_num_bytes);
+      slot_offset += copyable_num_bytes;
+      out_offset += copyable_num_bytes;
+
+      if (slot_offset == slot_byte_len) {
+        zeroize_memory(std::span<uint8_t>(slot));
+
+        slot_offset = 0;
+        num_consumed_slots.store(consumed + 1, std::memory_order_release);
+        num_consumed_slots.notify_one();
+      }
+    }
+  }
+
+  // Fills all slots and, in background mode, starts the worker thread.
+  forceinline void start()
+  {
+    static_cast<void>(refill());
+
+    if (mode == refill_mode_t::BACKGROUND_THREAD) {
+      worker = std::jthread([this]() { refill_forever(); });
+    }
+  }
+
+public:
+  using result_type = UIntType;
+
+  static constexpr auto seed_byte_len = csprng_t::seed_byte_len;
+  static constexpr auto min = std::numeric_limits<result_type>::min;
+  static constexpr auto max = std::numeric_limits<result_type>::max;
+
+  // Samples seed from the default entropy source, initializes the CSPRNG and fills all slots.
+  forceinline explicit randomshake_prefetching_t(const refill_mode_t refill_mode = refill_mode_t::BACKGROUND_THREAD)
+    : csprng(default_entropy_source_t{})
+    , mode(refill_mode)
+  {
+    start();
+  }
+
+  // Samples seed from given entropy source, initializes the CSPRNG and fills all slots.
+  template<typename source_t>
+    requires(entropy_source<std::remove_cvref_t<source_t>>)
+  forceinline explicit randomshake_prefetching_t(source_t&& source, const refill_mode_t refill_mode = refill_mode_t::BACKGROUND_THREAD)
+    : csprng(std::forward<source_t>(source))
+    , mode(refill_mode)
+  {
+    start();
+  }
+
+  // Initializes the CSPRNG using user supplied `seed_byte_len` -bytes seed and fills all slots.
+  forceinline explicit randomshake_prefetching_t(std::span<const uint8_t, seed_byte_len> seed,
+                                                 const refill_mode_t refill_mode = refill_mode_t::BACKGROUND_THREAD)
+    : csprng(seed)
+    , mode(refill_mode)
+  {
+    start();
+  }
+
+  // Delete copy and move constructors - as this CSPRNG instance is neither copyable nor movable.
+  randomshake_prefetching_t(const randomshake_prefetching_t&) = delete;
+  randomshake_prefetching_t(randomshake_prefetching_t&&) = delete;
+  randomshake_prefetching_t& operator=(const randomshake_prefetching_t&) = delete;
+  randomshake_prefetching_t& operator=(randomshake_prefetching_t&&) = delete;
+
+  // Stops the worker thread, if any, and zeroizes all slots.
+  ~randomshake_prefetching_t()
+  {
+    if (worker.joinable()) {
+      stop_requested.store(true, std::memory_order_release);
+
+      // Worker may be sleeping on the consumed slot counter, which must change for it to wake up. No one reads it anymore.
+      num_consumed_slots.fetch_add(1, std::memory_order_release);
+      num_consumed_slots.notify_one();
+
+      worker.join();
+    }
+
+    for (auto& slot : slots) {
+      slot.fill(0);
+    }
+    DoNotOptimize(slots);
+  }
+
+  /**
+   * Fills all free slots, returning how many of them were filled. Call it when the application is idle, so that next requests
+   * for random values don't have to wait for permutations. In background mode, the worker thread does it, so this returns 0.
+   */
+  forceinline size_t refill()
+  {
+    if (worker.joinable()) {
+      return 0;
+    }
+
+    size_t num_refilled_slots = 0;
+    while (num_filled_slots.load(std::memory_order_relaxed) < num_consumed_slots.load(std::memory_order_relaxed) + num_slots) {
+      fill_next_slot();
+      num_refilled_slots++;
+    }
+
+    return num_refilled_slots;
+  }
+
+  // Squeezes a random value of type `result_type`, from pre-squeezed slots.
+  [[nodiscard("Internal state of CSPRNG has changed, you should consume this value")]] forceinline result_type operator()()
+  {
+    std::array<uint8_t, sizeof(result_type)> bytes{};
+    read(bytes);
+
+    result_type result{};
+    std::memcpy(&result, bytes.data(), bytes.size());
+    return result;
+  }
+
+  // Squeezes n(>=0) random bytes, from pre-squeezed slots.
+  forceinline void generate(std::span<uint8_t> output) { read(output); }
+
+  // Fills `output` with random unsigned integers of type `T`, which doesn't need to be same as `result_type`.
+  template<typename T>
+    requires(std::is_unsigned_v<T> && !std::is_same_v<T, uint8_t> && !std::is_same_v<T, bool>)
+  forceinline void generate(std::span<T> output)
+  {
+    read(std::span<uint8_t>(reinterpret_cast<uint8_t*>(output.data()), output.size_bytes())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+};
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include "randomshake/entropy_source.hpp"
+#include "randomshake/fork_detection.hpp"
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace randomshake {
+
+// When a `randomshake_reseeding_t` instance mixes fresh entropy into its state.
+struct reseed_policy_t
+{
+  // Reseed once these many bytes are squeezed since the last reseed. Set to 0, for never reseeding based on output volume.
+  uint64_t reseed_interval_byte_len = 1UL << 30; // = 1GB
+
+  // Reseed before producing any output in a child process, created by `fork()`, so that parent and child don't emit the same stream.
+  bool reseed_on_fork = true;
+};
+
+/**
+ * Long-lived RandomSHAKE CSPRNG, which periodically mixes fresh entropy, sampled from an entropy source of type `source_t`,
+ * into its state, following a `reseed_policy_t`. Reseeding doesn't construct a new instance, see `randomshake_t::reseed`.
+ *
+ * When reseeding on fork is enabled, the fork generation is checked before producing any output, so that a generator, which
+ * was created before a pre-forking server `fork()`-ed its workers, never emits the same stream in two processes. For fork
+ * detection to work, make sure it is created before `fork()`-ing.
+ */
+template<typename UIntType = uint8_t, xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256, typename source_t = default_entropy_source_t>
+  requires(std::is_unsigned_v<UIntType> && entropy_source<source_t>)
+struct randomshake_reseeding_t
+{
+private:
+  randomshake_t<UIntType, xof_kind> csprng;
+  source_t source{};
+  reseed_policy_t policy{};
+
+  uint64_t bytes_since_reseed = 0;
+  uint64_t seeded_at_fork_gen = 0;
+  uint64_t num_reseeds = 0;
+
+  // Returns the number of bytes, which can be squeezed before next reseed, reseeding first, if it is already due.
+  forceinline uint64_t reseed_if_due()
+  {
+    if ((policy.reseed_on_fork && (seeded_at_fork_gen != fork_generation())) ||
+        ((policy.reseed_interval_byte_len != 0) && (bytes_since_reseed >= policy.reseed_interval_byte_len))) [[unlikely]] {
+      reseed();
+    }
+
+    return (policy.reseed_interval_byte_len == 0) ? std::numeric_limits<uint64_t>::max() : (policy.reseed_interval_byte_len - bytes_since_reseed);
+  }
+
+public:
+  using result_type = UIntType;
+
+  static constexpr auto seed_byte_len = randomshake_t<UIntType, xof_kind>::seed_byte_len;
+  static constexpr auto min = std::numeric_limits<result_type>::min;
+  static constexpr auto max = std::numeric_limits<result_type>::max;
+
+  // Samples `seed_byte_len` -many bytes from the entropy source and initializes the CSPRNG - making it ready for use.
+  forceinline explicit randomshake_reseeding_t(const reseed_policy_t reseed_policy = {}, source_t reseed_source = {})
+    : csprng(reseed_source)
+    , source(std::move(reseed_source))
+    , policy(reseed_policy)
+    , seeded_at_fork_gen(fork_generation())
+  {
+  }
+
+  /**
+   * Initializes the CSPRNG using user supplied `seed_byte_len` -bytes seed. Output stream is deterministic only until the
+   * first reseed, after which it also depends on the entropy source.
+   */
+  forceinline explicit randomshake_reseeding_t(std::span<const uint8_t, seed_byte_len> seed,
+                                               const reseed_policy_t reseed_policy = {},
+                                               source_t reseed_source = {})
+    : csprng(seed)
+    , source(std::move(reseed_source))
+    , policy(reseed_policy)
+    , seeded_at_fork_gen(fork_generation())
+  {
+  }
+
+  // Delete copy and move constructors - as this CSPRNG instance is neither copyable nor movable.
+  randomshake_reseeding_t(const randomshake_reseeding_t&) = delete;
+  randomshake_reseeding_t(randomshake_reseeding_t&&) = delete;
+  randomshake_reseeding_t& operator=(const randomshake_reseeding_t&) = delete;
+  randomshake_reseeding_t& operator=(randomshake_reseeding_t&&) = delete;
+  ~randomshake_reseeding_t() = default;
+
+  // Mixes fresh entropy into the CSPRNG, right now, restarting the reseed interval.
+  forceinline void reseed()
+  {
+    csprng.reseed(source);
+
+    bytes_since_reseed = 0;
+    seeded_at_fork_gen = fork_generation();
+    num_reseeds++;
+  }
+
+  // Number of times the CSPRNG has been reseeded, since construction.
+  [[nodiscard]] forceinline uint64_t reseed_count() const { return num_reseeds; }
+
+  // Squeezes a random value of type `result_type`, reseeding first, if due.
+  [[nodiscard("Internal state of CSPRNG has changed, you should consume this value")]] forceinline result_type operator()()
+  {
+    static_cast<void>(reseed_if_due());
+
+    bytes_since_reseed += sizeof(result_type);
+    return csprng();
+  }
+
+  // Squeezes n(>=0) random bytes. When a reseed falls due midway, it happens exactly after `reseed_interval_byte_len` -bytes.
+  forceinline void generate(std::span<uint8_t> output)
+  {
+    size_t out_offset = 0;
+
+    while (out_offset < output.size()) {
+      const uint64_t squeezable_num_bytes = reseed_if_due();
+      const auto num_bytes = static_cast<size_t>(std::min<uint64_t>(squeezable_num_bytes, output.size() - out_offset));
+
+      csprng.generate(output.subspan(out_offset, num_bytes));
+
+      bytes_since_reseed += num_bytes;
+      out_offset += num_bytes;
+    }
+  }
+
+  // Fills `output` with random unsigned integers of type `T`, which doesn't need to be same as `result_type`.
+  template<typename T>
+    requires(std::is_unsigned_v<T> && !std::is_same_v<T, uint8_t> && !std::is_same_v<T, bool>)
+  forceinline void generate(std::span<T> output)
+  {
+    generate(std::span<uint8_t>(reinterpret_cast<uint8_t*>(output.data()), output.size_bytes())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+};
+
+}
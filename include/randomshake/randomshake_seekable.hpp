@@ -0,0 +1,232 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace randomshake {
+
+// Domain separation label, absorbed first, into every XOF instance producing a block of the seekable CSPRNG's output stream.
+inline constexpr auto SEEKABLE_CSPRNG_DOMAIN = make_domain_label("RandomSHAKE/seekable");
+
+/**
+ * Seekable RandomSHAKE - counter-mode variant of RandomSHAKE CSPRNG, allowing O(1) jump to any position of its output stream.
+ *
+ * Output stream is split into blocks of `block_byte_len` -bytes. Block i is produced by squeezing a fresh XOF instance, after absorbing
+ *
+ * DOMAIN || SEED || LE64(i)
+ *
+ * As all blocks share the same prefix, XOF state after absorbing DOMAIN || SEED is computed once, at construction, and then
+ * copied for producing each block. As blocks are independent of each other, any of them can be (re)produced without
+ * producing the preceding ones, so a reproducible run can be resumed from a checkpoint or split across many threads.
+ *
+ * Note, unlike `randomshake_t`, there is no ratcheting. Anyone learning the seed (or the cached XOF state) can reproduce the
+ * whole output stream, both past and future. Use this variant only when random access is needed.
+ */
+template<typename UIntType = uint8_t, xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256>
+  requires(std::is_unsigned_v<UIntType> && check_endianness())
+struct randomshake_seekable_t
+{
+public:
+  using result_type = UIntType;
+
+  static constexpr auto seed_byte_len = xof_selector_t<xof_kind>::seed_byte_len;
+  static constexpr auto block_byte_len = xof_selector_t<xof_kind>::ratchet_period_byte_len;
+  static constexpr auto min = std::numeric_limits<result_type>::min;
+  static constexpr auto max = std::numeric_limits<result_type>::max;
+
+private:
+  using xof_t = xof_selector_t<xof_kind>::type;
+
+  xof_t seeded_state{};
+  std::array<uint8_t, block_byte_len> buffer{};
+  size_t buffer_offset = 0U;
+  uint64_t block_index = 0U;
+
+  // Absorbs the domain separation label and the seed, which are shared by all blocks.
+  forceinline constexpr void init(std::span<const uint8_t, seed_byte_len> seed)
+  {
+    seeded_state.reset();
+    seeded_state.absorb(SEEKABLE_CSPRNG_DOMAIN);
+    seeded_state.absorb(seed);
+
+    seek(0);
+  }
+
+  // Squeezes `output.size()` (<= `block_byte_len`) -bytes from the beginning of the block at index `blk_idx`.
+  forceinline constexpr void squeeze_block(const uint64_t blk_idx, std::span<uint8_t> output) const
+  {
+    std::array<uint8_t, sizeof(blk_idx)> blk_idx_bytes{};
+    std::memcpy(blk_idx_bytes.data(), &blk_idx, sizeof(blk_idx));
+
+    xof_t state = seeded_state;
+    state.absorb(blk_idx_bytes);
+    state.finalize();
+    state.squeeze(output);
+
+    state.reset();
+    DoNotOptimize(state);
+  }
+
+public:
+  // Samples `seed_byte_len` -many bytes from the default entropy source and initializes the CSPRNG - making it ready for use.
+  forceinline randomshake_seekable_t()
+    : randomshake_seekable_t(default_entropy_source_t{})
+  {
+  }
+
+  // Samples `seed_byte_len` -many bytes from given entropy source and initializes the CSPRNG. See `entropy_source.hpp`.
+  template<typename source_t>
+    requires(entropy_source<std::remove_cvref_t<source_t>>)
+  forceinline explicit randomshake_seekable_t(source_t&& source)
+  {
+    std::array<uint8_t, seed_byte_len> seed{};
+    auto seed_span = std::span(seed);
+
+    source.fill(seed_span);
+    init(seed_span);
+
+    seed.fill(0);
+    DoNotOptimize(seed);
+  }
+
+  // Explicit constructor. Expects user to supply us with `seed_byte_len` -bytes seed, for initializing the CSPRNG.
+  forceinline explicit constexpr randomshake_seekable_t(std::span<const uint8_t, seed_byte_len> seed) { init(seed); }
+
+  // Delete copy and move constructors - as this CSPRNG instance is neither copyable nor movable.
+  randomshake_seekable_t(const randomshake_seekable_t&) = delete;
+  randomshake_seekable_t(randomshake_seekable_t&&) = delete;
+  randomshake_seekable_t& operator=(const randomshake_seekable_t&) = delete;
+  randomshake_seekable_t& operator=(randomshake_seekable_t&&) = delete;
+
+  // Zeroize internal state when destroying an instance of CSPRNG.
+  ~randomshake_seekable_t()
+  {
+    seeded_state.reset();
+    DoNotOptimize(seeded_state);
+
+    buffer.fill(0);
+    DoNotOptimize(buffer);
+
+    buffer_offset = 0;
+    block_index = 0;
+  }
+
+  // Moves current position of the output stream to the beginning of the block at index `blk_idx`.
+  forceinline constexpr void seek(const uint64_t blk_idx)
+  {
+    squeeze_block(blk_idx, buffer);
+
+    block_index = blk_idx;
+    buffer_offset = 0;
+  }
+
+  // Returns current position of the output stream, as the number of bytes, preceding the next byte to be squeezed.
+  [[nodiscard]] forceinline constexpr uint64_t tell() const { return block_index * block_byte_len + buffer_offset; }
+
+  // Squeezes a random value of type `result_type`, from current position of the output stream.
+  [[nodiscard("Internal state of CSPRNG has changed, you should consume this value")]] forceinline result_type operator()()
+  {
+    constexpr size_t required_num_bytes = sizeof(result_type);
+    const size_t readble_num_bytes = buffer.size() - buffer_offset;
+
+    static_assert(block_byte_len % required_num_bytes == 0, "Buffer size nust be a multiple of `required_num_bytes`, for following seek to work correctly !");
+
+    // A preceding `generate` call may have left fewer than `required_num_bytes`, but non-zero, readable bytes in the buffer.
+    if ((readble_num_bytes != 0) && (readble_num_bytes < required_num_bytes)) {
+      std::array<uint8_t, required_num_bytes> result_bytes{};
+      generate(result_bytes);
+
+      result_type result{};
+      std::memcpy(&result, result_bytes.data(), required_num_bytes);
+
+      return result;
+    }
+
+    if (readble_num_bytes == 0) {
+      seek(block_index + 1);
+    }
+
+    result_type result{};
+    std::memcpy(&result, &buffer[buffer_offset], required_num_bytes);
+    buffer_offset += required_num_bytes;
+
+    return result;
+  }
+
+  // Squeezes n(>=0) random bytes, from current position of the output stream. Whole blocks are squeezed straight into `output`.
+  forceinline void generate(std::span<uint8_t> output)
+  {
+    size_t out_offset = 0;
+
+    while (out_offset < output.size()) {
+      const size_t readable_num_bytes = buffer.size() - buffer_offset;
+      const size_t required_num_bytes = output.size() - out_offset;
+
+      if (readable_num_bytes == 0) {
+        if (required_num_bytes >= block_byte_len) {
+          block_index++;
+          squeeze_block(block_index, output.subspan(out_offset, block_byte_len));
+          out_offset += block_byte_len;
+
+          continue;
+        }
+
+        seek(block_index + 1);
+        continue;
+      }
+
+      const size_t copyable_num_bytes = std::min(readable_num_bytes, required_num_bytes);
+      std::memcpy(&output[out_offset], &buffer[buffer_offset], copyable_num_bytes);
+
+      buffer_offset += copyable_num_bytes;
+      out_offset += copyable_num_bytes;
+    }
+  }
+
+  // Fills `output` with random unsigned integers of type `T`, from current position of the output stream.
+  template<typename T>
+    requires(std::is_unsigned_v<T> && !std::is_same_v<T, uint8_t> && !std::is_same_v<T, bool>)
+  forceinline void generate(std::span<T> output)
+  {
+    generate(std::span<uint8_t>(reinterpret_cast<uint8_t*>(output.data()), output.size_bytes())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+
+  /**
+   * Fills `output` with bytes of the output stream, starting at position `byte_offset`, without moving current position of
+   * the output stream. Doesn't modify the CSPRNG, so it is safe to call concurrently, from many threads, on the same instance.
+   */
+  forceinline void generate_at(const uint64_t byte_offset, std::span<uint8_t> output) const
+  {
+    uint64_t blk_idx = byte_offset / block_byte_len;
+    auto blk_offset = static_cast<size_t>(byte_offset % block_byte_len);
+    size_t out_offset = 0;
+
+    // Only the first and the last blocks may be partially covered, rest are squeezed straight into `output`.
+    std::array<uint8_t, block_byte_len> block{};
+
+    while (out_offset < output.size()) {
+      const size_t copyable_num_bytes = std::min(block_byte_len - blk_offset, output.size() - out_offset);
+
+      if (copyable_num_bytes == block_byte_len) {
+        squeeze_block(blk_idx, output.subspan(out_offset, block_byte_len));
+      } else {
+        squeeze_block(blk_idx, std::span(block).first(blk_offset + copyable_num_bytes));
+        std::memcpy(&output[out_offset], &block[blk_offset], copyable_num_bytes);
+      }
+
+      out_offset += copyable_num_bytes;
+      blk_offset = 0;
+      blk_idx++;
+    }
+
+    block.fill(0);
+    DoNotOptimize(block);
+  }
+};
+
+}
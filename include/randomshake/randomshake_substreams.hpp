@@ -0,0 +1,139 @@
+#pragma once
+#include "randomshake/entropy_source.hpp"
+#include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_compact.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace randomshake {
+
+// Domain separation label, absorbed first, into every XOF instance producing a substream of a common seed.
+inline constexpr auto SUBSTREAM_DOMAIN = make_domain_label("RandomSHAKE/substream");
+
+// Byte absorbed right after the seed, telling apart substreams derived from a byte string label from the ones derived from an id.
+inline constexpr uint8_t SUBSTREAM_LABEL_TAG = 0x00;
+inline constexpr uint8_t SUBSTREAM_ID_TAG = 0x01;
+
+/**
+ * Derives many independent, deterministic CSPRNG instances, say one per simulated entity, from a single seed. Child CSPRNG
+ * instances are `randomshake_compact_t`, with their XOF state initialized by absorbing
+ *
+ * derive(label)   : DOMAIN || SEED || 0x00 || LABEL
+ * substream(id)   : DOMAIN || SEED || 0x01 || LE64(ID)
+ *
+ * As all children share the same prefix, XOF state after absorbing DOMAIN || SEED is computed once, at construction, and then
+ * copied for deriving each child, which only absorbs the tag and the label or the id. As the label is the last thing absorbed,
+ * before finalization, and everything before it has fixed length, distinct (tag, label) pairs never collide. A child costs
+ * a copy of the XOF state and a short absorb, while finalization - a single permutation - is deferred until its first use.
+ *
+ * Children ratchet, just like `randomshake_t`. Anyone learning the seed (or the cached XOF state) can derive any child though,
+ * so keep this instance only as long as you need to derive new children. Deriving is const, so it is safe to derive children
+ * concurrently, from many threads.
+ */
+template<xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256>
+  requires(check_endianness())
+struct randomshake_substreams_t
+{
+public:
+  static constexpr auto seed_byte_len = xof_selector_t<xof_kind>::seed_byte_len;
+
+private:
+  using xof_t = xof_selector_t<xof_kind>::type;
+
+  xof_t seeded_state{};
+
+  // Absorbs the domain separation label and the seed, which are shared by all children.
+  forceinline constexpr void init(std::span<const uint8_t, seed_byte_len> seed)
+  {
+    seeded_state.reset();
+    seeded_state.absorb(SUBSTREAM_DOMAIN);
+    seeded_state.absorb(seed);
+  }
+
+  // Copies the cached XOF state and absorbs the tag, followed by `suffix`, into it.
+  template<typename UIntType, size_t ratchet_period_block_count>
+  [[nodiscard]] forceinline randomshake_compact_t<UIntType, xof_kind, ratchet_period_block_count> fork(const uint8_t tag, std::span<const uint8_t> suffix) const
+  {
+    const std::array<uint8_t, 1> tag_byte{ tag };
+
+    xof_t state = seeded_state;
+    state.absorb(tag_byte);
+    state.absorb(suffix);
+
+    randomshake_compact_t<UIntType, xof_kind, ratchet_period_block_count> child(state);
+
+    state.reset();
+    DoNotOptimize(state);
+
+    return child;
+  }
+
+public:
+  // Samples `seed_byte_len` -many bytes from the default entropy source and absorbs them - making it ready for deriving children.
+  forceinline randomshake_substreams_t()
+    : randomshake_substreams_t(default_entropy_source_t{})
+  {
+  }
+
+  // Samples `seed_byte_len` -many bytes from given entropy source and absorbs them. See `entropy_source.hpp`.
+  template<typename source_t>
+    requires(entropy_source<std::remove_cvref_t<source_t>>)
+  forceinline explicit randomshake_substreams_t(source_t&& source)
+  {
+    std::array<uint8_t, seed_byte_len> seed{};
+    auto seed_span = std::span(seed);
+
+    source.fill(seed_span);
+    init(seed_span);
+
+    seed.fill(0);
+    DoNotOptimize(seed);
+  }
+
+  // Explicit constructor. Expects user to supply us with `seed_byte_len` -bytes seed, shared by all children.
+  forceinline explicit constexpr randomshake_substreams_t(std::span<const uint8_t, seed_byte_len> seed) { init(seed); }
+
+  // Delete copy and move constructors - as this instance is neither copyable nor movable.
+  randomshake_substreams_t(const randomshake_substreams_t&) = delete;
+  randomshake_substreams_t(randomshake_substreams_t&&) = delete;
+  randomshake_substreams_t& operator=(const randomshake_substreams_t&) = delete;
+  randomshake_substreams_t& operator=(randomshake_substreams_t&&) = delete;
+
+  // Zeroize cached XOF state when destroying the instance.
+  ~randomshake_substreams_t()
+  {
+    seeded_state.reset();
+    DoNotOptimize(seeded_state);
+  }
+
+  // Derives the child CSPRNG, named by an arbitrary byte string `label`, say "entity/42". See above.
+  template<typename UIntType = uint8_t, size_t ratchet_period_block_count = default_ratchet_period_block_count<xof_kind>>
+  [[nodiscard]] forceinline randomshake_compact_t<UIntType, xof_kind, ratchet_period_block_count> derive(std::span<const uint8_t> label) const
+  {
+    return fork<UIntType, ratchet_period_block_count>(SUBSTREAM_LABEL_TAG, label);
+  }
+
+  // Derives the child CSPRNG, named by a string `label`, whose characters are absorbed as bytes. See above.
+  template<typename UIntType = uint8_t, size_t ratchet_period_block_count = default_ratchet_period_block_count<xof_kind>>
+  [[nodiscard]] forceinline randomshake_compact_t<UIntType, xof_kind, ratchet_period_block_count> derive(const std::string_view label) const
+  {
+    return derive<UIntType, ratchet_period_block_count>(
+      std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(label.data()), label.size())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+
+  // Derives the child CSPRNG, numbered by `id`, say index of an entity. See above.
+  template<typename UIntType = uint8_t, size_t ratchet_period_block_count = default_ratchet_period_block_count<xof_kind>>
+  [[nodiscard]] forceinline randomshake_compact_t<UIntType, xof_kind, ratchet_period_block_count> substream(const uint64_t id) const
+  {
+    std::array<uint8_t, sizeof(id)> id_bytes{};
+    std::memcpy(id_bytes.data(), &id, sizeof(id));
+
+    return fork<UIntType, ratchet_period_block_count>(SUBSTREAM_ID_TAG, id_bytes);
+  }
+};
+
+}
@@ -0,0 +1,274 @@
+#pragma once
+#include "randomshake/utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+#define RANDOMSHAKE_HAS_POSIX_MMAN 1
+#else
+#define RANDOMSHAKE_HAS_POSIX_MMAN 0
+#endif
+
+#if RANDOMSHAKE_HAS_POSIX_MMAN
+
+namespace randomshake {
+
+/**
+ * Secure Pool - a fixed-capacity arena of slots, each holding an instance of `T`, say `randomshake_t`, kept out of swap and
+ * core dumps.
+ *
+ * All slots live in a single anonymous memory mapping, which is `mlock()`-ed and excluded from core dumps, with
+ * `madvise(MADV_DONTDUMP)`, where supported, once, at construction. So creating and destroying instances doesn't make any
+ * system call, and only a single locked region counts against RLIMIT_MEMLOCK. Slots are cache-line aligned, so that instances
+ * used by different threads never share a cache line. Free slots are kept in a lock-free stack, with tagged heads avoiding the
+ * ABA problem, so instances can be created and destroyed concurrently, from many threads.
+ *
+ * Arenas spanning at least one 2 MiB huge page are first mapped with `MAP_HUGETLB`, so that a few huge pages cover all slots,
+ * sparing TLB entries, when many instances are in use. As huge pages are only available, if reserved by the administrator, see
+ * `vm.nr_hugepages`, the pool silently falls back to normal pages, asking for transparent huge pages with `madvise(MADV_HUGEPAGE)`,
+ * if mapping them fails. Smaller arenas always use normal pages, as rounding them up to a huge page would lock memory which is
+ * never used. `uses_huge_pages()` tells which one was picked.
+ *
+ * A slot is zeroized, right after its instance is destroyed, and the whole arena is zeroized, before being unmapped. All
+ * instances must be destroyed before the pool itself. If locking the mapping fails, say due to RLIMIT_MEMLOCK, the pool is
+ * still usable, but `is_locked()` returns false and `error()` tells why.
+ */
+template<typename T>
+struct secure_pool_t
+{
+private:
+  static constexpr size_t cache_line_byte_len = 64;
+  static constexpr size_t slot_alignment = std::max(alignof(T), cache_line_byte_len);
+
+  // Size of huge pages asked for, which is the default one on x86-64 and on AArch64 with 4 KiB base pages.
+  static constexpr size_t huge_page_byte_len = 2UL * 1'024UL * 1'024UL; // = 2MB
+
+  // Marks the end of the free list.
+  static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+  uint8_t* arena = nullptr;
+  size_t arena_byte_len = 0;
+  size_t num_slots = 0;
+
+  bool locked = false;
+  bool huge_pages = false;
+  int first_error = 0;
+
+  // Index of the slot following each free slot, in the free list.
+  std::unique_ptr<std::atomic<uint32_t>[]> next_free_slots; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+
+  // Low 32 bits hold index of the first free slot, while high 32 bits hold a tag, bumped on every update.
+  alignas(cache_line_byte_len) std::atomic<uint64_t> free_list_head{ NO_SLOT };
+
+  [[nodiscard]] forceinline static constexpr uint64_t make_head(const uint64_t prev_head, const uint32_t slot_idx)
+  {
+    return (((prev_head >> 32) + 1) << 32) | slot_idx;
+  }
+
+  [[nodiscard]] forceinline uint8_t* slot_ptr(const uint32_t slot_idx) const { return arena + static_cast<size_t>(slot_idx) * slot_byte_len; }
+
+  // Pops a free slot, returning `NO_SLOT`, if all slots are in use.
+  [[nodiscard]] forceinline uint32_t pop_free_slot()
+  {
+    uint64_t head = free_list_head.load(std::memory_order_acquire);
+
+    while (true) {
+      const auto slot_idx = static_cast<uint32_t>(head);
+      if (slot_idx == NO_SLOT) {
+        return NO_SLOT;
+      }
+
+      const uint32_t next_slot_idx = next_free_slots[slot_idx].load(std::memory_order_relaxed);
+      if (free_list_head.compare_exchange_weak(head, make_head(head, next_slot_idx), std::memory_order_acquire, std::memory_order_acquire)) {
+        return slot_idx;
+      }
+    }
+  }
+
+  // Pushes a free slot, making it available for reuse.
+  forceinline void push_free_slot(const uint32_t slot_idx)
+  {
+    uint64_t head = free_list_head.load(std::memory_order_relaxed);
+
+    do {
+      next_free_slots[slot_idx].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while (!free_list_head.compare_exchange_weak(head, make_head(head, slot_idx), std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  // Zeroizes the slot at index `slot_idx`.
+  forceinline void zeroize_slot(const uint32_t slot_idx) { zeroize_memory(std::span(slot_ptr(slot_idx), slot_byte_len)); }
+
+public:
+  // Byte length of each slot - `sizeof(T)`, rounded up to a multiple of cache-line size, or of `alignof(T)`, if larger.
+  static constexpr size_t slot_byte_len = ((sizeof(T) + slot_alignment - 1) / slot_alignment) * slot_alignment;
+
+  // Deleter for instances created using `make_unique`, returning their slot to the pool.
+  struct deleter_t
+  {
+    secure_pool_t* pool = nullptr;
+
+    void operator()(T* obj) const { pool->destroy(obj); }
+  };
+
+  // Owning pointer to an instance living in the pool.
+  using unique_ptr_t = std::unique_ptr<T, deleter_t>;
+
+  // Maps, locks and excludes from core dumps an arena of `capacity` -many slots. Capacity must be less than 2^32 - 1.
+  explicit secure_pool_t(const size_t capacity)
+  {
+    if ((capacity == 0) || (capacity >= NO_SLOT)) {
+      first_error = EINVAL;
+      return;
+    }
+
+    // Allocated before mapping the arena, so that a throwing allocation never leaks the locked mapping, as no destructor runs then.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+    next_free_slots = std::make_unique<std::atomic<uint32_t>[]>(capacity);
+
+    const size_t slots_byte_len = capacity * slot_byte_len;
+    void* mapping = MAP_FAILED; // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    if (slots_byte_len >= huge_page_byte_len) {
+      constexpr int huge_page_size_flag = std::countr_zero(huge_page_byte_len) << MAP_HUGE_SHIFT;
+
+      arena_byte_len = ((slots_byte_len + huge_page_byte_len - 1) / huge_page_byte_len) * huge_page_byte_len;
+      mapping = ::mmap(nullptr, arena_byte_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | huge_page_size_flag, -1, 0);
+      huge_pages = (mapping != MAP_FAILED); // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    }
+#endif
+
+    if (!huge_pages) {
+      const auto page_byte_len = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+      arena_byte_len = ((slots_byte_len + page_byte_len - 1) / page_byte_len) * page_byte_len;
+
+      mapping = ::mmap(nullptr, arena_byte_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+#ifdef MADV_HUGEPAGE
+      // Only a hint, which fails, if transparent huge pages are not supported, so its result is ignored.
+      if ((mapping != MAP_FAILED) && (arena_byte_len >= huge_page_byte_len)) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+        ::madvise(mapping, arena_byte_len, MADV_HUGEPAGE);
+      }
+#endif
+    }
+
+    if (mapping == MAP_FAILED) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+      first_error = errno;
+      arena_byte_len = 0;
+      next_free_slots.reset();
+      return;
+    }
+
+    arena = static_cast<uint8_t*>(mapping);
+    num_slots = capacity;
+
+    if (::mlock(arena, arena_byte_len) == 0) {
+      locked = true;
+    } else {
+      first_error = errno;
+    }
+
+#ifdef MADV_DONTDUMP
+    if ((::madvise(arena, arena_byte_len, MADV_DONTDUMP) != 0) && (first_error == 0)) {
+      first_error = errno;
+    }
+#endif
+
+    // Free list initially holds all slots, in increasing order of their index.
+    for (size_t slot_idx = 0; slot_idx < num_slots; slot_idx++) {
+      const uint32_t next_slot_idx = (slot_idx + 1 == num_slots) ? NO_SLOT : static_cast<uint32_t>(slot_idx + 1);
+      next_free_slots[slot_idx].store(next_slot_idx, std::memory_order_relaxed);
+    }
+    free_list_head.store(make_head(0, 0), std::memory_order_release);
+  }
+
+  // Delete copy and move constructors - as this pool is neither copyable nor movable.
+  secure_pool_t(const secure_pool_t&) = delete;
+  secure_pool_t(secure_pool_t&&) = delete;
+  secure_pool_t& operator=(const secure_pool_t&) = delete;
+  secure_pool_t& operator=(secure_pool_t&&) = delete;
+
+  // Zeroizes, unlocks and unmaps the arena. All instances must already be destroyed.
+  ~secure_pool_t()
+  {
+    if (arena == nullptr) {
+      return;
+    }
+
+    zeroize_memory(std::span(arena, arena_byte_len));
+
+    if (locked) {
+      ::munlock(arena, arena_byte_len);
+    }
+    ::munmap(arena, arena_byte_len);
+  }
+
+  // Number of slots in the pool.
+  [[nodiscard]] size_t capacity() const { return num_slots; }
+
+  // Whether the arena is locked in memory, so that it never gets swapped out.
+  [[nodiscard]] bool is_locked() const { return locked; }
+
+  // Whether the arena is backed by huge pages, mapped with `MAP_HUGETLB`, rather than by normal pages.
+  [[nodiscard]] bool uses_huge_pages() const { return huge_pages; }
+
+  // `errno` reported by the first failing system call, while setting up the arena, or 0, if all of them succeeded.
+  [[nodiscard]] int error() const { return first_error; }
+
+  /**
+   * Constructs an instance of `T` in a free slot, forwarding `args` to its constructor, and returns a pointer to it. Returns
+   * nullptr, if all slots are in use. Release it using `destroy`.
+   */
+  template<typename... Args>
+  [[nodiscard]] T* create(Args&&... args)
+  {
+    const uint32_t slot_idx = pop_free_slot();
+    if (slot_idx == NO_SLOT) {
+      return nullptr;
+    }
+
+    try {
+      return ::new (slot_ptr(slot_idx)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      zeroize_slot(slot_idx);
+      push_free_slot(slot_idx);
+      throw;
+    }
+  }
+
+  // Same as `create`, but returns an owning pointer, which destroys the instance and releases its slot, when it goes away.
+  template<typename... Args>
+  [[nodiscard]] unique_ptr_t make_unique(Args&&... args)
+  {
+    return unique_ptr_t(create(std::forward<Args>(args)...), deleter_t{ this });
+  }
+
+  // Destroys an instance, created by this pool, zeroizes its slot and makes it available for reuse. Does nothing for nullptr.
+  void destroy(T* obj)
+  {
+    if (obj == nullptr) {
+      return;
+    }
+
+    const auto slot_byte_offset = static_cast<size_t>(reinterpret_cast<uint8_t*>(obj) - arena); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto slot_idx = static_cast<uint32_t>(slot_byte_offset / slot_byte_len);
+
+    obj->~T();
+    zeroize_slot(slot_idx);
+    push_free_slot(slot_idx);
+  }
+};
+
+}
+
+#endif
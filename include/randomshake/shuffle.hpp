@@ -0,0 +1,211 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include "randomshake/uniform_int.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace randomshake {
+
+namespace shuffle_internals {
+
+/**
+ * Draws unbiased random indices from a stream of 64-bit words, squeezed from `csprng` in bulk, using D. Lemire's multiply-shift
+ * method. When the product of two consecutive bounds fits in 64 -bits, both indices are drawn from a single word, following
+ * N. Brackett-Rozinsky and D. Lemire's "Batched Ranged Random Integer Generation", https://arxiv.org/abs/2408.06213, halving
+ * the number of random bytes consumed by a shuffle.
+ */
+template<typename csprng_t>
+struct bounded_index_sampler_t
+{
+private:
+  static constexpr size_t WORD_BUFFER_LEN = 256;
+
+  csprng_t& csprng;
+  std::array<uint64_t, WORD_BUFFER_LEN> words{};
+  size_t word_offset = WORD_BUFFER_LEN;
+
+  forceinline uint64_t next_word()
+  {
+    if (word_offset == words.size()) [[unlikely]] {
+      csprng.generate(std::span<uint64_t>(words));
+      word_offset = 0;
+    }
+
+    return words[word_offset++];
+  }
+
+public:
+  // Largest bound, for which two indices can be drawn from a single word, as product of two such bounds fits in 64 -bits.
+  static constexpr uint64_t max_batchable_bound = uint64_t{ 1 } << (std::numeric_limits<uint64_t>::digits / 2);
+
+  forceinline explicit bounded_index_sampler_t(csprng_t& generator)
+    : csprng(generator)
+  {
+  }
+
+  bounded_index_sampler_t(const bounded_index_sampler_t&) = delete;
+  bounded_index_sampler_t(bounded_index_sampler_t&&) = delete;
+  bounded_index_sampler_t& operator=(const bounded_index_sampler_t&) = delete;
+  bounded_index_sampler_t& operator=(bounded_index_sampler_t&&) = delete;
+
+  // Zeroize buffered random words, when done.
+  ~bounded_index_sampler_t()
+  {
+    words.fill(0);
+    DoNotOptimize(words);
+  }
+
+  // Returns an index, sampled uniformly at random from [0, bound). Expects bound > 0.
+  forceinline uint64_t sample(const uint64_t bound)
+  {
+    auto [prod_hi, prod_lo] = widening_mul(next_word(), bound);
+
+    if (prod_lo < bound) [[unlikely]] {
+      const uint64_t threshold = (uint64_t{ 0 } - bound) % bound;
+
+      while (prod_lo < threshold) {
+        std::tie(prod_hi, prod_lo) = widening_mul(next_word(), bound);
+      }
+    }
+
+    return prod_hi;
+  }
+
+  // Returns a pair of indices, sampled uniformly at random from [0, bound_a) and [0, bound_b), using a single word, in most cases.
+  // Expects 0 < bound_a, bound_b <= `max_batchable_bound`.
+  forceinline std::pair<uint64_t, uint64_t> sample_pair(const uint64_t bound_a, const uint64_t bound_b)
+  {
+    const uint64_t product_bound = bound_a * bound_b;
+
+    while (true) {
+      const auto [idx_a, leftover_a] = widening_mul(next_word(), bound_a);
+      const auto [idx_b, leftover_b] = widening_mul(leftover_a, bound_b);
+
+      // Leftover is uniformly distributed over [0, 2^64), only after rejecting those below (2^64 - product_bound) mod product_bound.
+      if ((leftover_b >= product_bound) || (leftover_b >= (uint64_t{ 0 } - product_bound) % product_bound)) [[likely]] {
+        return { idx_a, idx_b };
+      }
+    }
+  }
+};
+
+/**
+ * Runs forward Fisher-Yates shuffle over a sequence of `n` elements, calling `swap(i, j)` for all i in [0, min(num_steps, n - 1)),
+ * in order, with j sampled uniformly at random from [i, n). When a step is batched with its following step, both are performed,
+ * even if the following one is at `num_steps`, so that the sequence of random words consumed doesn't depend on `num_steps`.
+ */
+template<typename csprng_t, typename swap_t>
+forceinline void
+fisher_yates(csprng_t& csprng, const uint64_t n, const uint64_t num_steps, swap_t&& swap)
+{
+  using sampler_t = bounded_index_sampler_t<csprng_t>;
+  sampler_t sampler(csprng);
+
+  uint64_t i = 0;
+  while ((i < num_steps) && (i + 1 < n)) {
+    const uint64_t remaining = n - i;
+
+    if ((remaining > 2) && (remaining <= sampler_t::max_batchable_bound)) {
+      const auto [offset_a, offset_b] = sampler.sample_pair(remaining, remaining - 1);
+
+      swap(i, i + offset_a);
+      swap(i + 1, i + 1 + offset_b);
+      i += 2;
+
+      continue;
+    }
+
+    swap(i, i + sampler.sample(remaining));
+    i += 1;
+  }
+}
+
+}
+
+/**
+ * Shuffles elements of `range` in-place, uniformly at random, using Fisher-Yates shuffle, with indices sampled in an unbiased
+ * manner, from random words squeezed from `csprng` in bulk. Most of the time, two indices are drawn from a single 64-bit word.
+ *
+ * Unlike `std::shuffle(begin, end, csprng)`, which goes through `std::uniform_int_distribution` for every swap, this needs one
+ * bulk squeeze for every ~512 swaps. Resulting permutation is a deterministic function of the CSPRNG's output stream.
+ */
+template<typename csprng_t, std::ranges::random_access_range range_t>
+  requires(std::ranges::sized_range<range_t> && bulk_generator<csprng_t, uint64_t>)
+forceinline void
+shuffle(csprng_t& csprng, range_t&& range)
+{
+  const auto first = std::ranges::begin(range);
+  const auto n = static_cast<uint64_t>(std::ranges::size(range));
+
+  shuffle_internals::fisher_yates(csprng, n, n, [&](const uint64_t i, const uint64_t j) {
+    std::ranges::iter_swap(first + static_cast<std::ranges::range_difference_t<range_t>>(i), first + static_cast<std::ranges::range_difference_t<range_t>>(j));
+  });
+}
+
+/**
+ * Samples `k` elements of `population`, uniformly at random, without replacement, returning them in random order. When `k`
+ * is larger than size of `population`, all of its elements are returned, shuffled.
+ *
+ * Runs the first `k` steps of the same Fisher-Yates shuffle as `shuffle` does, so the result is same as the first `k` elements
+ * of `population`, had it been shuffled by `shuffle`, using a CSPRNG in the same state. When `k` is small compared to the size
+ * of `population`, only displaced positions are tracked, in a hash map, so that it takes O(k) time and memory, instead of O(n).
+ */
+template<typename csprng_t, std::ranges::random_access_range range_t>
+  requires(std::ranges::sized_range<range_t> && bulk_generator<csprng_t, uint64_t>)
+[[nodiscard]] std::vector<std::ranges::range_value_t<range_t>>
+sample(csprng_t& csprng, const range_t& population, const size_t k)
+{
+  using value_t = std::ranges::range_value_t<range_t>;
+  using diff_t = std::ranges::range_difference_t<range_t>;
+
+  const auto n = static_cast<uint64_t>(std::ranges::size(population));
+  const auto num_samples = std::min<uint64_t>(k, n);
+
+  // Sampling a large fraction of the population, it's cheaper to shuffle a copy of it, than to track displacements.
+  constexpr uint64_t dense_sampling_ratio = 4;
+  if (num_samples * dense_sampling_ratio >= n) {
+    std::vector<value_t> values(std::ranges::begin(population), std::ranges::end(population));
+
+    shuffle_internals::fisher_yates(csprng, n, num_samples, [&](const uint64_t i, const uint64_t j) { std::swap(values[i], values[j]); });
+
+    values.resize(num_samples);
+    return values;
+  }
+
+  // Position p of the virtual array of indices holds `displaced[p]`, if present, otherwise p itself.
+  std::unordered_map<uint64_t, uint64_t> displaced{};
+  displaced.reserve(2 * num_samples + 2);
+
+  const auto index_at = [&](const uint64_t pos) {
+    const auto it = displaced.find(pos);
+    return (it == displaced.end()) ? pos : it->second;
+  };
+
+  shuffle_internals::fisher_yates(csprng, n, num_samples, [&](const uint64_t i, const uint64_t j) {
+    const uint64_t idx_i = index_at(i);
+    const uint64_t idx_j = index_at(j);
+
+    displaced[i] = idx_j;
+    displaced[j] = idx_i;
+  });
+
+  const auto first = std::ranges::begin(population);
+
+  std::vector<value_t> values{};
+  values.reserve(num_samples);
+  for (uint64_t i = 0; i < num_samples; i++) {
+    values.push_back(*(first + static_cast<diff_t>(index_at(i))));
+  }
+
+  return values;
+}
+
+}
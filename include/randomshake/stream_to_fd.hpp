@@ -0,0 +1,179 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <semaphore>
+#include <span>
+#include <thread>
+
+#if __has_include(<unistd.h>)
+#include <cerrno>
+#include <unistd.h>
+#define RANDOMSHAKE_HAS_POSIX_WRITE 1
+#else
+#define RANDOMSHAKE_HAS_POSIX_WRITE 0
+#endif
+
+#if RANDOMSHAKE_HAS_POSIX_WRITE
+
+namespace randomshake {
+
+// Default byte length of each of the two buffers, `stream_to_fd` squeezes random bytes into, before writing them out.
+inline constexpr size_t STREAM_TO_FD_DEFAULT_BLOCK_BYTE_LEN = 1'024UL * 1'024UL; // = 1MB
+
+// Buffers are aligned to, and their byte length is rounded up to a multiple of, the page size of most platforms.
+inline constexpr size_t STREAM_TO_FD_BUFFER_ALIGNMENT = 4'096;
+
+// Zeroizes a buffer of `byte_len` -bytes, allocated by `stream_to_fd`, before freeing it.
+struct stream_to_fd_buffer_deleter_t
+{
+  size_t byte_len = 0;
+
+  void operator()(uint8_t* bytes) const
+  {
+    zeroize_memory(std::span(bytes, byte_len));
+    ::operator delete(bytes, std::align_val_t{ STREAM_TO_FD_BUFFER_ALIGNMENT });
+  }
+};
+
+// Outcome of streaming random bytes to a file descriptor.
+struct stream_stats_t
+{
+  // Number of bytes written to the file descriptor. Equals the requested byte length, unless `error` is set.
+  uint64_t num_bytes_written = 0;
+
+  // `errno` reported by the failing `write()`, or 0, if all bytes were written.
+  int error = 0;
+
+  // Wall-clock time taken, from start of generation to end of the last write.
+  double seconds = 0.;
+
+  // Sustained throughput, in gigabytes (10^9 bytes) per second.
+  [[nodiscard]] double gigabytes_per_second() const { return (seconds > 0.) ? (static_cast<double>(num_bytes_written) / seconds / 1e9) : 0.; }
+};
+
+/**
+ * Writes `num_bytes` -many random bytes, squeezed from `csprng`, to the file descriptor `fd` - a file, a block device, a pipe
+ * or a socket. Use it for wiping devices or producing large test corpora.
+ *
+ * Random bytes are squeezed into two page-aligned buffers, of `block_byte_len` -bytes each, in turn. While the calling thread
+ * fills one of them, a writer thread drains the other one with `write()`, so that generation and I/O overlap, instead of
+ * leaving the CPU or the device idle. Partial writes and EINTR are retried. On any other error, streaming stops and the error
+ * is reported in the returned stats, along with the number of bytes which made it to `fd`. A `write()` making no progress, by
+ * returning 0, is reported as EIO.
+ *
+ * Bytes are written in the same order they are squeezed, so the written stream is same as what `csprng.generate` would have
+ * produced. Buffers are zeroized, before returning. `fd` is neither closed nor synced.
+ *
+ * Note, `vmsplice()` and io_uring are deliberately not used. `vmsplice()` only works on pipes and hands the pipe references to
+ * the buffer pages, rather than copies, so the next squeeze or the final zeroization would overwrite bytes not yet read by the
+ * other end. And io_uring needs a recent Linux kernel plus liburing, which this header-only library doesn't depend on, while
+ * a single `write()` per block already overlaps I/O with generation, which bounds the throughput.
+ */
+template<typename csprng_t>
+  requires(bulk_generator<csprng_t, uint8_t>)
+stream_stats_t
+stream_to_fd(csprng_t& csprng, const int fd, const uint64_t num_bytes, const size_t block_byte_len = STREAM_TO_FD_DEFAULT_BLOCK_BYTE_LEN)
+{
+  constexpr size_t num_buffers = 2;
+
+  stream_stats_t stats{};
+  if (num_bytes == 0) {
+    return stats;
+  }
+
+  const size_t buffer_byte_len =
+    std::max<size_t>(1, (block_byte_len + STREAM_TO_FD_BUFFER_ALIGNMENT - 1) / STREAM_TO_FD_BUFFER_ALIGNMENT) * STREAM_TO_FD_BUFFER_ALIGNMENT;
+  const uint64_t num_blocks = (num_bytes + buffer_byte_len - 1) / buffer_byte_len;
+
+  const auto block_len = [&](const uint64_t block_idx) {
+    return static_cast<size_t>(std::min<uint64_t>(buffer_byte_len, num_bytes - block_idx * buffer_byte_len));
+  };
+
+  struct buffer_t
+  {
+    std::unique_ptr<uint8_t[], stream_to_fd_buffer_deleter_t> bytes; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+    std::binary_semaphore is_filled{ 0 };
+    std::binary_semaphore is_drained{ 1 };
+  };
+
+  // Buffers are zeroized and freed on every way out, including an exception thrown while allocating them or spawning the writer.
+  std::array<buffer_t, num_buffers> buffers{};
+  for (auto& buffer : buffers) {
+    buffer.bytes = decltype(buffer.bytes)(static_cast<uint8_t*>(::operator new(buffer_byte_len, std::align_val_t{ STREAM_TO_FD_BUFFER_ALIGNMENT })),
+                                          stream_to_fd_buffer_deleter_t{ buffer_byte_len });
+  }
+
+  std::atomic<int> write_error{ 0 };
+  std::atomic<uint64_t> num_bytes_written{ 0 };
+
+  const auto start = std::chrono::steady_clock::now();
+
+  {
+    // Drains buffers in the order they are filled, stopping at the first failing `write()`.
+    std::jthread writer([&]() {
+      for (uint64_t block_idx = 0; block_idx < num_blocks; block_idx++) {
+        auto& buffer = buffers[block_idx % num_buffers];
+        buffer.is_filled.acquire();
+
+        const auto block = std::span(buffer.bytes.get(), block_len(block_idx));
+        size_t block_offset = 0;
+
+        while (block_offset < block.size()) {
+          const auto remaining = block.subspan(block_offset);
+          const auto written = ::write(fd, remaining.data(), remaining.size());
+
+          if (written < 0) {
+            if (errno == EINTR) {
+              continue;
+            }
+
+            write_error.store(errno, std::memory_order_release);
+            break;
+          }
+
+          // Retrying a `write()`, which makes no progress, would spin forever, holding the buffer.
+          if (written == 0) {
+            write_error.store(EIO, std::memory_order_release);
+            break;
+          }
+
+          block_offset += static_cast<size_t>(written);
+          num_bytes_written.fetch_add(static_cast<uint64_t>(written), std::memory_order_relaxed);
+        }
+
+        buffer.is_drained.release();
+        if (write_error.load(std::memory_order_acquire) != 0) {
+          return;
+        }
+      }
+    });
+
+    for (uint64_t block_idx = 0; block_idx < num_blocks; block_idx++) {
+      auto& buffer = buffers[block_idx % num_buffers];
+      buffer.is_drained.acquire();
+
+      if (write_error.load(std::memory_order_acquire) != 0) {
+        break;
+      }
+
+      csprng.generate(std::span(buffer.bytes.get(), block_len(block_idx)));
+      buffer.is_filled.release();
+    }
+  }
+
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  stats.num_bytes_written = num_bytes_written.load(std::memory_order_relaxed);
+  stats.error = write_error.load(std::memory_order_relaxed);
+
+  return stats;
+}
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+#pragma once
+#include "randomshake/fork_detection.hpp"
+#include "randomshake/randomshake.hpp"
+#include "sha3/turboshake256.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <span>
+
+namespace randomshake {
+
+// Domain separation label, absorbed first, when deriving the seed of a thread-local CSPRNG instance from the master seed.
+inline constexpr auto THREAD_LOCAL_CSPRNG_DOMAIN = make_domain_label("RandomSHAKE/thread_local_csprng");
+
+// Byte length of the process-wide master seed, from which seeds of all thread-local CSPRNG instances are derived.
+inline constexpr size_t THREAD_LOCAL_CSPRNG_MASTER_SEED_BYTE_LEN = xof_selector_t<xof_kind_t::TURBOSHAKE256>::seed_byte_len;
+
+// Index handed out to the next thread-local CSPRNG instance being created, so that no two instances share a seed.
+inline std::atomic<uint64_t> thread_local_csprng_next_index{ 0 };
+
+/**
+ * Returns the process-wide master seed, which is sampled from the default entropy source, only once, on first call.
+ * Initialization is thread-safe, while later calls only cost a check of the initialization guard. Master seed is zeroized
+ * when the process exits normally, by a handler registered with `std::atexit`, right after sampling it.
+ */
+forceinline const std::array<uint8_t, THREAD_LOCAL_CSPRNG_MASTER_SEED_BYTE_LEN>&
+thread_local_csprng_master_seed()
+{
+  static std::array<uint8_t, THREAD_LOCAL_CSPRNG_MASTER_SEED_BYTE_LEN> master_seed{};
+  static const bool is_master_seed_sampled = []() {
+    default_entropy_source_t{}.fill(std::span(master_seed));
+    std::atexit([]() { zeroize_memory(std::span<uint8_t>(master_seed)); });
+
+    return true;
+  }();
+  static_cast<void>(is_master_seed_sampled);
+
+  return master_seed;
+}
+
+/**
+ * Derives seed of a thread-local CSPRNG instance, by squeezing `seed.size()` -bytes from TurboSHAKE256, after absorbing
+ *
+ * DOMAIN || MASTER_SEED || LE64(INSTANCE_INDEX) || LE64(FORK_GENERATION) || FRESH_ENTROPY
+ *
+ * where FRESH_ENTROPY is non-empty, only in a forked child process, so that two children, forked from the same parent,
+ * don't end up with same seed, for the same instance index.
+ */
+template<size_t seed_byte_len>
+forceinline void
+derive_thread_local_csprng_seed(std::span<uint8_t, seed_byte_len> seed, const uint64_t instance_index, const uint64_t fork_gen)
+{
+  std::array<uint8_t, sizeof(instance_index) + sizeof(fork_gen)> indices{};
+  std::memcpy(indices.data(), &instance_index, sizeof(instance_index));
+  std::memcpy(std::span(indices).subspan(sizeof(instance_index)).data(), &fork_gen, sizeof(fork_gen));
+
+  turboshake256::turboshake256_t xof{};
+  xof.reset();
+  xof.absorb(THREAD_LOCAL_CSPRNG_DOMAIN);
+  xof.absorb(thread_local_csprng_master_seed());
+  xof.absorb(indices);
+
+  if (fork_gen != 0) {
+    std::array<uint8_t, THREAD_LOCAL_CSPRNG_MASTER_SEED_BYTE_LEN> fresh_entropy{};
+    default_entropy_source_t{}.fill(std::span(fresh_entropy));
+    xof.absorb(fresh_entropy);
+
+    fresh_entropy.fill(0);
+    DoNotOptimize(fresh_entropy);
+  }
+
+  xof.finalize();
+  xof.squeeze(seed);
+
+  xof.reset();
+  DoNotOptimize(xof);
+}
+
+/**
+ * Returns the RandomSHAKE CSPRNG instance owned by the calling thread, creating it lazily, on first call from a thread.
+ *
+ * Each instance is seeded with a seed derived from a single process-wide master seed, which is sampled from the default
+ * entropy source only once. So all but the very first instance skip the costly non-deterministic seeding. No locks are taken on this path,
+ * apart from the one-time initialization of the master seed.
+ *
+ * In a child process, created by `fork()`, the instance is detected to be stale and re-seeded on next call, mixing in fresh
+ * entropy. Hence, don't hold on to the returned reference across `fork()` - rather call this function, everytime you need
+ * random values. Instance is zeroized when the thread exits.
+ */
+template<typename UIntType = uint8_t, xof_kind_t xof_kind = xof_kind_t::TURBOSHAKE256>
+forceinline randomshake_t<UIntType, xof_kind>&
+thread_local_csprng()
+{
+  using csprng_t = randomshake_t<UIntType, xof_kind>;
+
+  thread_local std::optional<csprng_t> csprng{};
+  thread_local uint64_t seeded_at_fork_gen = 0;
+  thread_local uint64_t instance_index = 0;
+
+  const auto fork_gen = fork_generation();
+  if (!csprng.has_value() || (seeded_at_fork_gen != fork_gen)) [[unlikely]] {
+    if (!csprng.has_value()) {
+      instance_index = thread_local_csprng_next_index.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+    derive_thread_local_csprng_seed(std::span(seed), instance_index, fork_gen);
+
+    csprng.emplace(seed);
+    seeded_at_fork_gen = fork_gen;
+
+    seed.fill(0);
+    DoNotOptimize(seed);
+  }
+
+  return *csprng;
+}
+
+}
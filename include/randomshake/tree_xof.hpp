@@ -0,0 +1,180 @@
+#pragma once
+#include "randomshake/keccak_multistate.hpp"
+#include "randomshake/randomshake.hpp"
+#include "randomshake/utils.hpp"
+#include "sha3/turboshake256.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+namespace randomshake {
+
+// Domain separation label, absorbed first, into every leaf sponge of a tree XOF.
+inline constexpr auto TREE_XOF_LEAF_DOMAIN = make_domain_label("RandomSHAKE/tree_xof/leaf");
+
+/**
+ * Tree XOF - KangarooTwelve-style tree mode, expanding the absorbed input into `num_leaves`-many independent TurboSHAKE256
+ * leaf sponges, which are permuted side-by-side, in SIMD registers. See `keccak_multistate.hpp`.
+ *
+ * Input is absorbed into a root TurboSHAKE256 sponge. On finalization, a chaining value of `chaining_value_byte_len` -bytes is
+ * squeezed from the root sponge, which is then zeroized, and leaf i is initialized by absorbing
+ *
+ * DOMAIN || CHAINING_VALUE || LE64(i)
+ *
+ * Output stream is a sequence of stripes, where stripe j is the concatenation of j-th rate block squeezed from leaf 0, then
+ * leaf 1, ..., then leaf `num_leaves - 1`. Every stripe costs a single multi-state permutation. Ratcheting ratchets every leaf,
+ * dropping unread bytes of the current stripe.
+ *
+ * It offers the same API as the XOFs from sha3 library, so that it can back RandomSHAKE CSPRNG, as `xof_kind_t::TURBOSHAKE256_TREE`.
+ * Being trivially copyable, it can also back `generate_parallel`, which spreads output over threads, one subtree per chunk.
+ */
+template<size_t num_leaves>
+  requires((num_leaves > 1) && (num_leaves <= 8))
+struct tree_xof_t
+{
+private:
+  using leaf_sponges_t = multistate_sponge_t<xof_kind_t::TURBOSHAKE256, num_leaves>;
+
+public:
+  static constexpr size_t leaf_rate_byte_len = leaf_sponges_t::rate_byte_len;
+  static constexpr size_t stripe_byte_len = num_leaves * leaf_rate_byte_len;
+  static constexpr size_t chaining_value_byte_len = 2 * turboshake256::TARGET_BIT_SECURITY_LEVEL / std::numeric_limits<uint8_t>::digits;
+
+private:
+  static constexpr size_t leaf_msg_byte_len = TREE_XOF_LEAF_DOMAIN.size() + chaining_value_byte_len + sizeof(uint64_t);
+  static_assert(leaf_msg_byte_len < leaf_rate_byte_len, "Leaf message must fit in a single padded rate block !");
+
+  turboshake256::turboshake256_t root{};
+  leaf_sponges_t leaves{};
+  std::array<uint8_t, stripe_byte_len> stripe{};
+  size_t stripe_offset = stripe_byte_len;
+
+  // Squeezes `output.size() / stripe_byte_len` -many whole stripes into `output`, one multi-state permutation per stripe.
+  forceinline constexpr void squeeze_stripes(std::span<uint8_t> output)
+  {
+    for (size_t stripe_begin = 0; stripe_begin < output.size(); stripe_begin += stripe_byte_len) {
+      leaves.squeeze_block(
+        [&](const size_t leaf_idx) { return output.subspan(stripe_begin + leaf_idx * leaf_rate_byte_len).template first<leaf_rate_byte_len>(); });
+    }
+  }
+
+public:
+  // Resets the root sponge, for absorbing new input, and zeroizes the leaf sponges.
+  forceinline constexpr void reset()
+  {
+    root.reset();
+    leaves.reset();
+
+    stripe.fill(0);
+    stripe_offset = stripe_byte_len;
+  }
+
+  // Absorbs `msg` into the root sponge. Can be called many times, before finalizing.
+  forceinline constexpr void absorb(std::span<const uint8_t> msg) { root.absorb(msg); }
+
+  // Finalizes the root sponge, derives the chaining value and initializes all leaf sponges, making them ready for squeezing.
+  forceinline constexpr void finalize()
+  {
+    std::array<uint8_t, leaf_msg_byte_len> leaf_msg{};
+    std::copy(TREE_XOF_LEAF_DOMAIN.begin(), TREE_XOF_LEAF_DOMAIN.end(), leaf_msg.begin());
+
+    auto chaining_value = std::span(leaf_msg).subspan(TREE_XOF_LEAF_DOMAIN.size(), chaining_value_byte_len);
+    root.finalize();
+    root.squeeze(chaining_value);
+    root.reset();
+
+    leaves.reset();
+    for (size_t leaf_idx = 0; leaf_idx < num_leaves; leaf_idx++) {
+      for (size_t byte_idx = 0; byte_idx < sizeof(uint64_t); byte_idx++) {
+        leaf_msg[TREE_XOF_LEAF_DOMAIN.size() + chaining_value_byte_len + byte_idx] = static_cast<uint8_t>(static_cast<uint64_t>(leaf_idx) >> (byte_idx * 8));
+      }
+
+      leaves.absorb_block(leaf_idx, leaf_msg);
+      leaves.pad(leaf_idx, leaf_msg.size());
+    }
+    leaves.finalize();
+
+    leaf_msg.fill(0);
+    DoNotOptimize(leaf_msg);
+
+    stripe_offset = stripe_byte_len;
+  }
+
+  // Squeezes `output.size()` -bytes from the output stream. Whole stripes are squeezed straight into `output`.
+  forceinline constexpr void squeeze(std::span<uint8_t> output)
+  {
+    size_t out_offset = 0;
+
+    while (out_offset < output.size()) {
+      const size_t readable_num_bytes = stripe.size() - stripe_offset;
+      const size_t required_num_bytes = output.size() - out_offset;
+
+      if (readable_num_bytes == 0) {
+        if (required_num_bytes >= stripe_byte_len) {
+          const size_t whole_stripes_byte_len = required_num_bytes - (required_num_bytes % stripe_byte_len);
+
+          squeeze_stripes(output.subspan(out_offset, whole_stripes_byte_len));
+          out_offset += whole_stripes_byte_len;
+
+          continue;
+        }
+
+        squeeze_stripes(stripe);
+        stripe_offset = 0;
+
+        continue;
+      }
+
+      const size_t copyable_num_bytes = std::min(readable_num_bytes, required_num_bytes);
+      std::copy_n(stripe.begin() + static_cast<std::ptrdiff_t>(stripe_offset), copyable_num_bytes, output.begin() + static_cast<std::ptrdiff_t>(out_offset));
+
+      stripe_offset += copyable_num_bytes;
+      out_offset += copyable_num_bytes;
+    }
+  }
+
+  /**
+   * Ratchets every leaf sponge, zeroizing first `ratchet_byte_len` -bytes of TurboSHAKE256 of its permutation state and
+   * re-applying the permutation, and drops unread bytes of current stripe. Leaves are always ratcheted by that many bytes,
+   * which is what RandomSHAKE CSPRNG asks for, so `byte_len` is only there to match the API of XOFs from sha3 library.
+   */
+  forceinline constexpr void ratchet([[maybe_unused]] const size_t byte_len)
+  {
+    leaves.ratchet();
+
+    stripe.fill(0);
+    stripe_offset = stripe_byte_len;
+  }
+};
+
+// Specialization for KangarooTwelve-style tree of TurboSHAKE256 leaf sponges. See `tree_xof_t`.
+template<>
+struct xof_selector_t<xof_kind_t::TURBOSHAKE256_TREE>
+{
+  // Number of leaf sponges, each of them contributing one rate block to every stripe. Fills AVX-512 registers.
+  static constexpr size_t num_leaves = 8;
+
+  using type = tree_xof_t<num_leaves>;
+
+  // Bit width of a stripe i.e. one rate block from each leaf sponge.
+  static constexpr size_t rate = type::stripe_byte_len * std::numeric_limits<uint8_t>::digits;
+
+  // Required seed byte length to initialize the root TurboSHAKE256 sponge.
+  static constexpr size_t seed_byte_len = turboshake256::RATE / std::numeric_limits<uint8_t>::digits;
+
+  /**
+   * Everytime these many bytes are squeezed from the tree, we zeroize first `ratchet_byte_len`-bytes of Keccak permutation
+   * state of every leaf sponge and re-apply 12-rounds permutation.
+   *
+   * Ratchet period gets computed as `8 x stripe-width` bits, which is 8 rate blocks from each leaf sponge, same as TurboSHAKE256.
+   */
+  static constexpr size_t ratchet_period_byte_len = rate;
+
+  // First these many bytes of keccak permutation state, of every leaf sponge, are zeroized during ratcheting.
+  static constexpr size_t ratchet_byte_len = xof_selector_t<xof_kind_t::TURBOSHAKE256>::ratchet_byte_len;
+};
+
+}
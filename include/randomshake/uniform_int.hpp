@@ -0,0 +1,152 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace randomshake {
+
+/**
+ * Computes full-width product of two unsigned words, returning its (high, low) halves.
+ * Uses 128-bit integer arithmetic for 64-bit words, when the compiler supports it, otherwise falls back to schoolbook multiplication.
+ */
+template<typename word_t>
+  requires(std::is_same_v<word_t, uint32_t> || std::is_same_v<word_t, uint64_t>)
+forceinline constexpr std::pair<word_t, word_t>
+widening_mul(const word_t lhs, const word_t rhs)
+{
+  constexpr auto word_bw = std::numeric_limits<word_t>::digits;
+
+  if constexpr (std::is_same_v<word_t, uint32_t>) {
+    const uint64_t prod = static_cast<uint64_t>(lhs) * static_cast<uint64_t>(rhs);
+    return { static_cast<word_t>(prod >> word_bw), static_cast<word_t>(prod) };
+  } else {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128_t = unsigned __int128;
+
+    const auto prod = static_cast<uint128_t>(lhs) * static_cast<uint128_t>(rhs);
+    return { static_cast<word_t>(prod >> word_bw), static_cast<word_t>(prod) };
+#else
+    constexpr uint64_t mask32 = std::numeric_limits<uint32_t>::max();
+
+    const uint64_t lhs_lo = lhs & mask32, lhs_hi = lhs >> 32;
+    const uint64_t rhs_lo = rhs & mask32, rhs_hi = rhs >> 32;
+
+    const uint64_t lo_lo = lhs_lo * rhs_lo;
+    const uint64_t hi_lo = lhs_hi * rhs_lo;
+    const uint64_t lo_hi = lhs_lo * rhs_hi;
+    const uint64_t hi_hi = lhs_hi * rhs_hi;
+
+    const uint64_t cross = (lo_lo >> 32) + (hi_lo & mask32) + lo_hi;
+    const uint64_t hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    const uint64_t lo = (cross << 32) | (lo_lo & mask32);
+
+    return { hi, lo };
+#endif
+  }
+}
+
+// Unsigned word type, random values of which are mapped onto integers of type `T`. At least 32-bits wide, so that rejections are rare.
+template<std::integral T>
+using uniform_int_word_t = std::conditional_t<(sizeof(T) <= sizeof(uint32_t)), uint32_t, uint64_t>;
+
+/**
+ * Fills `output` with integers, sampled uniformly at random from the closed interval [lo, hi], using random words
+ * squeezed from `csprng` in bulk. Expects lo <= hi.
+ *
+ * Each word w, of bit-width L, is mapped to lo + floor((w * s) / 2^L), where s = hi - lo + 1, which is unbiased after
+ * rejecting the words for which (w * s) mod 2^L < (2^L - s) mod s. This is D. Lemire's "nearly divisionless" method,
+ * described in https://arxiv.org/abs/1805.10941. Rejection is possible only when (w * s) mod 2^L < s, which happens with
+ * probability s / 2^L, so words are mapped in a branch-free loop, over a whole chunk, which compilers can auto-vectorize,
+ * while the rare rejections are fixed up in a separate pass, drawing replacement words one at a time.
+ *
+ * Output is a deterministic function of the CSPRNG's output stream, and exactly as many words are consumed as needed.
+ * Squeezed words, both the chunks and the replacements of rejected ones, are zeroized before returning.
+ */
+template<typename csprng_t, std::integral T>
+  requires(!std::is_same_v<T, bool> && bulk_generator<csprng_t, uniform_int_word_t<T>>)
+forceinline void
+uniform_int_fill(csprng_t& csprng, std::span<T> output, const std::type_identity_t<T> lo, const std::type_identity_t<T> hi)
+{
+  using word_t = uniform_int_word_t<T>;
+  using uint_t = std::make_unsigned_t<T>;
+
+  constexpr size_t CHUNK_LEN = 256;
+
+  // Width of the interval, less one. Computed in unsigned arithmetic, so that it is well-defined for signed types too.
+  const auto span_len_minus_one = static_cast<word_t>(static_cast<uint_t>(static_cast<uint_t>(hi) - static_cast<uint_t>(lo)));
+  const auto offset_from_lo = [lo](const word_t val) { return static_cast<T>(static_cast<uint_t>(static_cast<uint_t>(lo) + static_cast<uint_t>(val))); };
+
+  std::array<word_t, CHUNK_LEN> words{};
+  auto words_span = std::span(words);
+
+  // Interval covers the whole range of word type, so no mapping is required.
+  if (span_len_minus_one == std::numeric_limits<word_t>::max()) {
+    for (size_t out_offset = 0; out_offset < output.size(); out_offset += CHUNK_LEN) {
+      const size_t chunk_len = std::min(CHUNK_LEN, output.size() - out_offset);
+      auto chunk = words_span.first(chunk_len);
+
+      csprng.generate(chunk);
+      std::ranges::transform(chunk, output.subspan(out_offset, chunk_len).begin(), offset_from_lo);
+    }
+
+    words.fill(0);
+    DoNotOptimize(words);
+
+    return;
+  }
+
+  const word_t span_len = span_len_minus_one + 1;
+  const word_t threshold = static_cast<word_t>(word_t{ 0 } - span_len) % span_len;
+
+  // Replacement words, for rejected ones, are drawn into it, so that it is wiped along with the chunk.
+  std::array<word_t, 1> word{};
+
+  for (size_t out_offset = 0; out_offset < output.size(); out_offset += CHUNK_LEN) {
+    const size_t chunk_len = std::min(CHUNK_LEN, output.size() - out_offset);
+    auto chunk = words_span.first(chunk_len);
+    auto out_chunk = output.subspan(out_offset, chunk_len);
+
+    csprng.generate(chunk);
+
+    // Branch-free pass, mapping every word onto the interval, while noting whether any word may need to be rejected.
+    bool may_need_rejection = false;
+    for (size_t i = 0; i < chunk_len; i++) {
+      const auto [prod_hi, prod_lo] = widening_mul(chunk[i], span_len);
+
+      out_chunk[i] = offset_from_lo(prod_hi);
+      may_need_rejection |= (prod_lo < span_len);
+    }
+
+    if (!may_need_rejection) {
+      continue;
+    }
+
+    // Rare pass, replacing mapped values of rejected words, by drawing fresh words, one at a time.
+    for (size_t i = 0; i < chunk_len; i++) {
+      auto [prod_hi, prod_lo] = widening_mul(chunk[i], span_len);
+
+      while (prod_lo < threshold) {
+        csprng.generate(std::span<word_t>(word));
+
+        std::tie(prod_hi, prod_lo) = widening_mul(word[0], span_len);
+      }
+
+      out_chunk[i] = offset_from_lo(prod_hi);
+    }
+  }
+
+  words.fill(0);
+  DoNotOptimize(words);
+
+  word.fill(0);
+  DoNotOptimize(word);
+}
+
+}
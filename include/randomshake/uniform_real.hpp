@@ -0,0 +1,76 @@
+#pragma once
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace randomshake {
+
+// Unsigned word type, random values of which are converted to floating-point values of type `F`. Wide enough to fill its significand.
+template<std::floating_point F>
+  requires(std::numeric_limits<F>::is_iec559 && (std::numeric_limits<F>::digits <= std::numeric_limits<uint64_t>::digits))
+using uniform_real_word_t = std::conditional_t<(std::numeric_limits<F>::digits <= std::numeric_limits<uint32_t>::digits), uint32_t, uint64_t>;
+
+/**
+ * Fills `output` with floating-point values, sampled uniformly at random from the half-open interval [0, 1), using random
+ * words squeezed from `csprng` in bulk.
+ *
+ * Each word contributes its top `std::numeric_limits<F>::digits` bits (24 for float, 53 for double), which are scaled by
+ * 2^-digits. Both the integer-to-float conversion and the scaling are exact, so every representable multiple of 2^-digits
+ * in [0, 1) is equally likely, and the conversion loop is free of branches, allowing compilers to auto-vectorize it.
+ * Exactly one word is consumed per output value. Squeezed words are zeroized before returning.
+ */
+template<typename csprng_t, std::floating_point F>
+  requires(bulk_generator<csprng_t, uniform_real_word_t<F>>)
+forceinline void
+uniform_real_fill(csprng_t& csprng, std::span<F> output)
+{
+  using word_t = uniform_real_word_t<F>;
+
+  constexpr size_t CHUNK_LEN = 256;
+  constexpr auto num_dropped_bits = std::numeric_limits<word_t>::digits - std::numeric_limits<F>::digits;
+  constexpr auto scale = static_cast<F>(1) / static_cast<F>(word_t{ 1 } << std::numeric_limits<F>::digits);
+
+  std::array<word_t, CHUNK_LEN> words{};
+  auto words_span = std::span(words);
+
+  for (size_t out_offset = 0; out_offset < output.size(); out_offset += CHUNK_LEN) {
+    const size_t chunk_len = std::min(CHUNK_LEN, output.size() - out_offset);
+    auto chunk = words_span.first(chunk_len);
+
+    csprng.generate(chunk);
+    std::ranges::transform(chunk, output.subspan(out_offset, chunk_len).begin(), [](const word_t word) {
+      return static_cast<F>(word >> num_dropped_bits) * scale;
+    });
+  }
+
+  words.fill(0);
+  DoNotOptimize(words);
+}
+
+/**
+ * Fills `output` with floating-point values, sampled uniformly at random from the half-open interval [lo, hi), by scaling
+ * values sampled from [0, 1). Expects lo < hi and (hi - lo) to be finite.
+ *
+ * Results, which would be rounded up to `hi`, are clamped to the largest representable value below `hi`, so that the
+ * interval stays half-open.
+ */
+template<typename csprng_t, std::floating_point F>
+  requires(bulk_generator<csprng_t, uniform_real_word_t<F>>)
+forceinline void
+uniform_real_fill(csprng_t& csprng, std::span<F> output, const std::type_identity_t<F> lo, const std::type_identity_t<F> hi)
+{
+  uniform_real_fill(csprng, output);
+
+  const F width = hi - lo;
+  const F below_hi = std::nextafter(hi, lo);
+
+  std::ranges::transform(output, output.begin(), [=](const F unit) { return std::min(lo + width * unit, below_hi); });
+}
+
+}
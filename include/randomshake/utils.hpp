@@ -0,0 +1,69 @@
+#pragma once
+#include "sha3/internals/force_inline.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace randomshake {
+
+// Compile-time check to ensure that endianness is little, as correctness of program depends on it.
+consteval auto
+check_endianness()
+{
+  return std::endian::native == std::endian::little;
+}
+
+/**
+ * Ensures that value is materialized (and not optimized away), but doesn't clobber memory, like google-benchmark does.
+ * Taken from https://theunixzoo.co.uk/blog/2021-10-14-preventing-optimisations.html.
+ *
+ * Values larger than a register, such as zeroized buffers, are only ever passed as memory operands, as google-benchmark does
+ * too. Letting the compiler pick between register and memory alternatives, for those, may have it operate on a temporary copy,
+ * leaving stores to the value itself free to be dropped.
+ */
+template<typename Tp>
+forceinline void
+DoNotOptimize(Tp& value)
+{
+  if constexpr (std::is_trivially_copyable_v<Tp> && (sizeof(Tp) <= sizeof(Tp*))) {
+    asm volatile("" : "+r,m"(value) : :); // NOLINT(hicpp-no-assembler)
+  } else {
+    asm volatile("" : "+m"(value) : :); // NOLINT(hicpp-no-assembler)
+  }
+}
+
+/**
+ * Zeroizes memory backing `values`, followed by a compiler barrier on that memory, so that the stores are never dropped, even
+ * when the memory is freed, unmapped or reused right after. Unlike `DoNotOptimize`, which keeps a value, say a pointer, alive,
+ * it keeps the bytes the pointer points to.
+ */
+template<typename T>
+  requires(std::is_trivially_copyable_v<T>)
+forceinline void
+zeroize_memory(std::span<T> values)
+{
+  std::memset(static_cast<void*>(values.data()), 0, values.size_bytes());
+  asm volatile("" : : "r"(values.data()) : "memory"); // NOLINT(hicpp-no-assembler)
+}
+
+/**
+ * Converts a string literal into a byte array, dropping the trailing NUL character, at compile-time.
+ * Used for defining domain separation labels, which are absorbed into XOF instances.
+ */
+template<size_t N>
+consteval std::array<uint8_t, N - 1>
+make_domain_label(const char (&label)[N]) // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+{
+  std::array<uint8_t, N - 1> bytes{};
+  for (size_t i = 0; i < bytes.size(); i++) {
+    bytes[i] = static_cast<uint8_t>(label[i]);
+  }
+
+  return bytes;
+}
+
+}
@@ -0,0 +1,138 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_batch.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Checks that instance i of the batch produces the same output stream as a `randomshake_t`, seeded with seed i, when
+// interleaving per-instance values, per-instance byte sequences and byte sequences squeezed from all instances at once.
+template<size_t num_instances, randomshake::xof_kind_t xof_kind, size_t ratchet_period_block_count = randomshake::default_ratchet_period_block_count<xof_kind>>
+void
+test_batch_csprng_output_streams_are_same()
+{
+  using csprng_t = randomshake::randomshake_t<uint64_t, xof_kind, ratchet_period_block_count>;
+  using batch_csprng_t = randomshake::randomshake_batch_t<num_instances, uint64_t, xof_kind, ratchet_period_block_count>;
+
+  constexpr size_t seed_byte_len = batch_csprng_t::seed_byte_len;
+  constexpr size_t ratchet_period_byte_len = batch_csprng_t::ratchet_period_byte_len;
+
+  std::array<uint8_t, num_instances * seed_byte_len> seeds{};
+  std::vector<std::unique_ptr<csprng_t>> csprngs;
+
+  for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+    const auto seed = std::span(seeds).subspan(instance_idx * seed_byte_len, seed_byte_len);
+    std::ranges::fill(seed, static_cast<uint8_t>(instance_idx));
+
+    csprngs.push_back(std::make_unique<csprng_t>(std::span<const uint8_t, seed_byte_len>(seed)));
+  }
+
+  auto batch_csprng = std::make_unique<batch_csprng_t>(seeds);
+
+  for (const size_t byte_len : { size_t{ 0 }, size_t{ 16 }, size_t{ 135 }, ratchet_period_byte_len - 3, 2 * ratchet_period_byte_len + 7 }) {
+    // Drain instances unevenly, so that they run out of buffered bytes at different times.
+    for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+      for (size_t i = 0; i < instance_idx; i++) {
+        EXPECT_EQ((*batch_csprng)(instance_idx), (*csprngs[instance_idx])());
+      }
+
+      std::vector<uint8_t> expected(byte_len + instance_idx, 0);
+      std::vector<uint8_t> computed(expected.size(), 0);
+
+      csprngs[instance_idx]->generate(expected);
+      batch_csprng->generate(instance_idx, computed);
+
+      EXPECT_EQ(computed, expected);
+    }
+
+    std::vector<uint8_t> computed(num_instances * byte_len, 0);
+    batch_csprng->generate_all(computed);
+
+    for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+      std::vector<uint8_t> expected(byte_len, 0);
+      csprngs[instance_idx]->generate(expected);
+
+      EXPECT_EQ(std::vector<uint8_t>(computed.begin() + static_cast<ptrdiff_t>(instance_idx * byte_len),
+                                     computed.begin() + static_cast<ptrdiff_t>((instance_idx + 1) * byte_len)),
+                expected);
+    }
+  }
+}
+
+}
+
+TEST(RandomSHAKEBatch, Output_Streams_Are_Same_As_Separate_RandomSHAKE_Instances)
+{
+  test_batch_csprng_output_streams_are_same<1, randomshake::xof_kind_t::TURBOSHAKE256>();
+  test_batch_csprng_output_streams_are_same<7, randomshake::xof_kind_t::TURBOSHAKE256>();
+  test_batch_csprng_output_streams_are_same<5, randomshake::xof_kind_t::SHAKE256>();
+  test_batch_csprng_output_streams_are_same<5, randomshake::xof_kind_t::SHAKE128>();
+  test_batch_csprng_output_streams_are_same<5, randomshake::xof_kind_t::TURBOSHAKE128>();
+  test_batch_csprng_output_streams_are_same<4, randomshake::xof_kind_t::TURBOSHAKE256, 1>();
+
+  // More instances than are refilled together, so that exhausted instances are refilled in many groups, the last one partial.
+  test_batch_csprng_output_streams_are_same<11, randomshake::xof_kind_t::TURBOSHAKE256>();
+  test_batch_csprng_output_streams_are_same<19, randomshake::xof_kind_t::SHAKE128, 1>();
+}
+
+TEST(RandomSHAKEBatch, Refill_Leaves_Instances_With_Buffered_Bytes_Untouched)
+{
+  constexpr size_t num_instances = 4;
+  using batch_csprng_t = randomshake::randomshake_batch_t<num_instances, uint64_t>;
+
+  std::array<uint8_t, num_instances * batch_csprng_t::seed_byte_len> seeds{};
+  seeds.fill(0xde);
+
+  batch_csprng_t batch_csprng(seeds);
+  batch_csprng_t reference(seeds);
+
+  // Exhausts instance 0 only, then refills.
+  std::vector<uint8_t> drained(batch_csprng_t::ratchet_period_byte_len, 0);
+  batch_csprng.generate(0, drained);
+  reference.generate(0, drained);
+  batch_csprng.refill();
+
+  for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+    EXPECT_EQ(batch_csprng(instance_idx), reference(instance_idx));
+  }
+}
+
+TEST(RandomSHAKEBatch, Generate_All_Fills_Every_Byte_When_Output_Length_Is_Not_A_Multiple)
+{
+  constexpr size_t num_instances = 4;
+  using csprng_t = randomshake::randomshake_t<uint64_t>;
+  using batch_csprng_t = randomshake::randomshake_batch_t<num_instances, uint64_t>;
+
+  constexpr size_t seed_byte_len = batch_csprng_t::seed_byte_len;
+
+  std::array<uint8_t, num_instances * seed_byte_len> seeds{};
+  for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+    std::ranges::fill(std::span(seeds).subspan(instance_idx * seed_byte_len, seed_byte_len), static_cast<uint8_t>(instance_idx + 1));
+  }
+
+  batch_csprng_t batch_csprng(seeds);
+
+  // 4 * 5 + 3 bytes, so first three instances fill 6 bytes each, while the last one fills 5 bytes.
+  std::vector<uint8_t> computed(num_instances * 5 + 3, 0);
+  batch_csprng.generate_all(computed);
+
+  size_t chunk_begin = 0;
+  for (size_t instance_idx = 0; instance_idx < num_instances; instance_idx++) {
+    const auto seed = std::span(seeds).subspan(instance_idx * seed_byte_len, seed_byte_len);
+    csprng_t csprng(std::span<const uint8_t, seed_byte_len>{ seed });
+
+    std::vector<uint8_t> expected(instance_idx < 3 ? 6 : 5, 0);
+    csprng.generate(expected);
+
+    EXPECT_EQ(std::vector<uint8_t>(computed.begin() + static_cast<ptrdiff_t>(chunk_begin),
+                                   computed.begin() + static_cast<ptrdiff_t>(chunk_begin + expected.size())),
+              expected);
+    chunk_begin += expected.size();
+  }
+
+  EXPECT_EQ(chunk_begin, computed.size());
+}
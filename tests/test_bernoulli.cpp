@@ -0,0 +1,151 @@
+#include "randomshake/bernoulli.hpp"
+#include "randomshake/randomshake.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Checks that the fraction of successful trials is within 5 standard deviations of p.
+void
+test_bernoulli_fill_success_rate(const double p)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<uint8_t> trials(1'000'000, 0xff);
+  randomshake::bernoulli_fill(csprng, std::span(trials), p);
+
+  EXPECT_TRUE(std::ranges::all_of(trials, [](const uint8_t trial) { return trial <= 1; }));
+
+  const auto num_trials = static_cast<double>(trials.size());
+  const auto success_rate = static_cast<double>(std::accumulate(trials.begin(), trials.end(), size_t{ 0 })) / num_trials;
+  const double std_dev = std::sqrt(p * (1. - p) / num_trials);
+
+  EXPECT_NEAR(success_rate, p, 5. * std_dev + 1e-12);
+}
+
+// Checks that mean and variance of binomial samples are within a few standard errors of n * p and n * p * (1 - p).
+void
+test_binomial_fill_moments(const uint32_t num_trials, const double p)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<uint32_t> samples(100'000, 0);
+  randomshake::binomial_fill(csprng, std::span(samples), num_trials, p);
+
+  EXPECT_TRUE(std::ranges::all_of(samples, [&](const uint32_t sample) { return sample <= num_trials; }));
+
+  const auto num_samples = static_cast<double>(samples.size());
+  const double mean = std::accumulate(samples.begin(), samples.end(), 0., [](const double acc, const uint32_t val) { return acc + val; }) / num_samples;
+  const double variance =
+    std::accumulate(samples.begin(), samples.end(), 0., [&](const double acc, const uint32_t val) { return acc + (val - mean) * (val - mean); }) / num_samples;
+
+  const double expected_mean = num_trials * p;
+  const double expected_variance = num_trials * p * (1. - p);
+
+  EXPECT_NEAR(mean, expected_mean, 5. * std::sqrt(expected_variance / num_samples));
+  EXPECT_NEAR(variance, expected_variance, .05 * expected_variance);
+}
+
+}
+
+TEST(RandomSHAKEBernoulli, Fair_Coin_Consumes_One_Bit_Per_Trial)
+{
+  // A trial succeeds iff its bit is 0. Bits of a word are read from the most significant one.
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = { 0x5555555555555555ULL } };
+
+  std::vector<uint8_t> trial_bytes(64 * 3 + 5, 0);
+  randomshake::bernoulli_fill(generator, std::span(trial_bytes), .5);
+
+  for (size_t i = 0; i < trial_bytes.size(); i++) {
+    EXPECT_EQ(trial_bytes[i], (i % 2 == 0) ? 1 : 0);
+  }
+}
+
+TEST(RandomSHAKEBernoulli, Fair_Coin_Squeezes_Only_Words_It_Needs)
+{
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = { 0x5555555555555555ULL } };
+
+  std::array<uint8_t, 1> trial{};
+  randomshake::bernoulli_fill(generator, std::span<uint8_t>(trial), .5);
+  EXPECT_EQ(generator.num_generated_words, 1U);
+
+  std::vector<uint8_t> trial_bytes(64 * 3 + 5, 0);
+  randomshake::bernoulli_fill(generator, std::span(trial_bytes), .5);
+  EXPECT_EQ(generator.num_generated_words, 1U + 4U);
+
+  // For p = 0.75 = 0.11b, words for the mean of 1.5 bits per trial are squeezed first. Bits 0 10 10 10 ... take 8191 bits, in
+  // 4096 trials, so the rest is squeezed one word at a time, as needed, up to 128 words.
+  std::vector<uint8_t> biased_trial_bytes(64 * 64, 0);
+  randomshake::bernoulli_fill(generator, std::span(biased_trial_bytes), .75);
+  EXPECT_EQ(generator.num_generated_words, 1U + 4U + 128U);
+}
+
+TEST(RandomSHAKEBernoulli, Biased_Coin_Stops_At_First_Differing_Bit)
+{
+  // p = 0.25 = 0.01b. Bits 00 succeed, while bits 01 and 1 fail. 0x0C... = 00 00 1 1 0...
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = { 0x0C00000000000000ULL } };
+
+  std::array<bool, 4> trials{};
+  randomshake::bernoulli_fill(generator, std::span<bool>(trials), .25);
+
+  EXPECT_EQ(trials, (std::array<bool, 4>{ true, true, false, false }));
+}
+
+TEST(RandomSHAKEBernoulli, Success_Rate_Matches_Probability)
+{
+  test_bernoulli_fill_success_rate(.5);
+  test_bernoulli_fill_success_rate(.25);
+  test_bernoulli_fill_success_rate(.3);
+  test_bernoulli_fill_success_rate(1e-3);
+  test_bernoulli_fill_success_rate(.999);
+}
+
+TEST(RandomSHAKEBernoulli, Degenerate_Probabilities_Consume_No_Randomness)
+{
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = { 0 } };
+
+  std::vector<uint8_t> trials(1'024, 0xff);
+  randomshake::bernoulli_fill(generator, std::span(trials), 0.);
+  EXPECT_TRUE(std::ranges::all_of(trials, [](const uint8_t trial) { return trial == 0; }));
+
+  randomshake::bernoulli_fill(generator, std::span(trials), 1.);
+  EXPECT_TRUE(std::ranges::all_of(trials, [](const uint8_t trial) { return trial == 1; }));
+
+  std::vector<uint32_t> samples(16, 0);
+  randomshake::binomial_fill(generator, std::span(samples), 1'000U, 1.);
+  EXPECT_TRUE(std::ranges::all_of(samples, [](const uint32_t sample) { return sample == 1'000; }));
+
+  EXPECT_EQ(generator.num_generated_words, 0U);
+}
+
+TEST(RandomSHAKEBernoulli, Binomial_Of_Fair_Coin_Counts_Zero_Bits)
+{
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = { 0xFFFFFFFF00000000ULL } };
+
+  // Each sample of 100 trials consumes two words, of which only the top 36 bits of the second one are used.
+  std::array<uint32_t, 3> samples{};
+  randomshake::binomial_fill(generator, std::span<uint32_t>(samples), 100U, .5);
+
+  EXPECT_EQ(samples, (std::array<uint32_t, 3>{ 32 + 4, 32 + 4, 32 + 4 }));
+}
+
+TEST(RandomSHAKEBernoulli, Binomial_Moments_Match_Distribution)
+{
+  test_binomial_fill_moments(1'000, .5);
+  test_binomial_fill_moments(100, .1);
+  test_binomial_fill_moments(37, .9);
+  test_binomial_fill_moments(1, .3);
+}
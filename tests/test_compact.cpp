@@ -0,0 +1,118 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_compact.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Compact CSPRNG holds nothing but the XOF state and a counter - no buffer of squeezed bytes.
+static_assert(sizeof(randomshake::randomshake_compact_t<>) ==
+                sizeof(randomshake::xof_selector_t<randomshake::xof_kind_t::TURBOSHAKE256>::type) + sizeof(size_t),
+              "Compact CSPRNG must not hold a buffer !");
+static_assert(10 * sizeof(randomshake::randomshake_compact_t<>) <= 6 * sizeof(randomshake::randomshake_t<>), "Compact CSPRNG must be at least 40% smaller !");
+
+// Checks that compact CSPRNG produces the same output stream as `randomshake_t`, when interleaving values and byte sequences
+// of lengths crossing ratchet period boundaries.
+template<randomshake::xof_kind_t xof_kind, size_t ratchet_period_block_count = randomshake::default_ratchet_period_block_count<xof_kind>>
+void
+test_compact_csprng_output_stream_is_same()
+{
+  using csprng_t = randomshake::randomshake_t<uint32_t, xof_kind, ratchet_period_block_count>;
+  using compact_csprng_t = randomshake::randomshake_compact_t<uint32_t, xof_kind, ratchet_period_block_count>;
+
+  constexpr size_t ratchet_period_byte_len = csprng_t::ratchet_period_byte_len;
+  static_assert(compact_csprng_t::ratchet_period_byte_len == ratchet_period_byte_len);
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  csprng_t csprng(seed);
+  compact_csprng_t compact_csprng(seed);
+
+  for (const size_t byte_len :
+       { size_t{ 0 }, size_t{ 1 }, size_t{ 135 }, ratchet_period_byte_len - 3, 2 * ratchet_period_byte_len + 7, ratchet_period_byte_len }) {
+    std::vector<uint8_t> expected(byte_len, 0);
+    std::vector<uint8_t> computed(byte_len, 0);
+
+    csprng.generate(expected);
+    compact_csprng.generate(computed);
+    EXPECT_EQ(computed, expected);
+
+    for (size_t i = 0; i < 5; i++) {
+      EXPECT_EQ(compact_csprng(), csprng());
+    }
+
+    std::vector<uint64_t> expected_u64s(byte_len / sizeof(uint64_t), 0);
+    std::vector<uint64_t> computed_u64s(expected_u64s.size(), 0);
+
+    csprng.generate(std::span(expected_u64s));
+    compact_csprng.generate(std::span(computed_u64s));
+    EXPECT_EQ(computed_u64s, expected_u64s);
+  }
+}
+
+}
+
+TEST(RandomSHAKECompact, Output_Stream_Is_Same_As_RandomSHAKE)
+{
+  test_compact_csprng_output_stream_is_same<randomshake::xof_kind_t::SHAKE256>();
+  test_compact_csprng_output_stream_is_same<randomshake::xof_kind_t::TURBOSHAKE256>();
+  test_compact_csprng_output_stream_is_same<randomshake::xof_kind_t::SHAKE128>();
+  test_compact_csprng_output_stream_is_same<randomshake::xof_kind_t::TURBOSHAKE128>();
+}
+
+TEST(RandomSHAKECompact, Output_Stream_Is_Same_As_RandomSHAKE_With_Custom_Ratchet_Period)
+{
+  test_compact_csprng_output_stream_is_same<randomshake::xof_kind_t::TURBOSHAKE256, 1>();
+  test_compact_csprng_output_stream_is_same<randomshake::xof_kind_t::TURBOSHAKE256, 3>();
+}
+
+TEST(RandomSHAKECompact, Moved_To_Instance_Continues_Output_Stream)
+{
+  std::array<uint8_t, randomshake::randomshake_compact_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_compact_t<uint64_t> reference(seed);
+  randomshake::randomshake_compact_t<uint64_t> csprng(seed);
+
+  // Moving a not yet finalized instance, as well as a finalized one.
+  randomshake::randomshake_compact_t<uint64_t> moved_to(std::move(csprng));
+  EXPECT_EQ(moved_to(), reference());
+
+  std::vector<randomshake::randomshake_compact_t<uint64_t>> csprngs;
+  csprngs.push_back(std::move(moved_to));
+
+  for (size_t i = 0; i < 1'000; i++) {
+    EXPECT_EQ(csprngs.front()(), reference());
+  }
+}
+
+TEST(RandomSHAKECompactDeathTest, Using_Moved_From_Instance_Aborts)
+{
+  std::array<uint8_t, randomshake::randomshake_compact_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_compact_t<uint64_t> csprng(seed);
+  randomshake::randomshake_compact_t<uint64_t> moved_to(std::move(csprng));
+
+  std::array<uint8_t, 16> output{};
+
+  // NOLINTBEGIN(bugprone-use-after-move,hicpp-invalid-access-moved)
+  EXPECT_DEATH(std::ignore = csprng(), "");
+  EXPECT_DEATH(csprng.generate(std::span(output)), "");
+
+  // Same after move assignment, while assigning to a moved-from instance makes it usable again.
+  randomshake::randomshake_compact_t<uint64_t> assigned_to(seed);
+  assigned_to = std::move(moved_to);
+  EXPECT_DEATH(std::ignore = moved_to(), "");
+
+  randomshake::randomshake_compact_t<uint64_t> reference(seed);
+  csprng = std::move(assigned_to);
+  EXPECT_EQ(csprng(), reference());
+  // NOLINTEND(bugprone-use-after-move,hicpp-invalid-access-moved)
+}
@@ -0,0 +1,221 @@
+#include "randomshake/constant_time.hpp"
+#include "randomshake/randomshake.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template<typename T>
+void
+test_uniform_int_ct_fill_stays_within_interval(const T lo, const T hi)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<T> values(1'024 * 16, 0);
+  randomshake::uniform_int_ct_fill(csprng, std::span(values), lo, hi);
+
+  EXPECT_TRUE(std::ranges::all_of(values, [&](const T val) { return (lo <= val) && (val <= hi); }));
+}
+
+// Checks that fixed-cost draws produce the same output stream as the functor, across many ratchet periods, starting from
+// buffer positions left by `generate` calls of every length up to the width of a value, which misalign it.
+template<typename T, randomshake::xof_kind_t xof_kind>
+void
+test_next_ct_matches_functor()
+{
+  using csprng_t = randomshake::randomshake_t<T, xof_kind>;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  csprng_t csprng_a(seed);
+  csprng_t csprng_b(seed);
+
+  constexpr size_t num_values_per_round = 2 * csprng_t::ratchet_period_byte_len / sizeof(T) + 1;
+
+  for (size_t misalignment = 0; misalignment <= sizeof(T); misalignment++) {
+    std::vector<uint8_t> bytes_a(misalignment, 0);
+    std::vector<uint8_t> bytes_b(misalignment, 0);
+    csprng_a.generate(bytes_a);
+    csprng_b.generate(bytes_b);
+    EXPECT_EQ(bytes_a, bytes_b);
+
+    for (size_t i = 0; i < num_values_per_round; i++) {
+      EXPECT_EQ(csprng_a.next_ct(), csprng_b());
+    }
+  }
+}
+
+}
+
+TEST(RandomSHAKEConstantTime, Greater_Than_Mask_Matches_Comparison)
+{
+  constexpr std::array<uint64_t, 8> edge_values = {
+    0, 1, 2, (1ULL << 63) - 1, 1ULL << 63, (1ULL << 63) + 1, std::numeric_limits<uint64_t>::max() - 1, std::numeric_limits<uint64_t>::max()
+  };
+
+  for (const auto x : edge_values) {
+    for (const auto y : edge_values) {
+      EXPECT_EQ(randomshake::ct_gt_mask(x, y), (x > y) ? std::numeric_limits<uint64_t>::max() : 0);
+    }
+  }
+}
+
+TEST(RandomSHAKEConstantTime, Conditional_Swap_Swaps_Only_When_Asked)
+{
+  std::array<uint8_t, 3> a = { 1, 2, 3 };
+  std::array<uint8_t, 3> b = { 4, 5, 6 };
+
+  randomshake::ct_conditional_swap(0, a, b);
+  EXPECT_EQ(a, (std::array<uint8_t, 3>{ 1, 2, 3 }));
+  EXPECT_EQ(b, (std::array<uint8_t, 3>{ 4, 5, 6 }));
+
+  randomshake::ct_conditional_swap(std::numeric_limits<uint64_t>::max(), a, b);
+  EXPECT_EQ(a, (std::array<uint8_t, 3>{ 4, 5, 6 }));
+  EXPECT_EQ(b, (std::array<uint8_t, 3>{ 1, 2, 3 }));
+}
+
+TEST(RandomSHAKEConstantTime, Fixed_Cost_Draw_Matches_Functor_At_Any_Buffer_Position)
+{
+  test_next_ct_matches_functor<uint8_t, randomshake::xof_kind_t::TURBOSHAKE256>();
+  test_next_ct_matches_functor<uint32_t, randomshake::xof_kind_t::TURBOSHAKE256>();
+  test_next_ct_matches_functor<uint64_t, randomshake::xof_kind_t::TURBOSHAKE256>();
+  test_next_ct_matches_functor<uint64_t, randomshake::xof_kind_t::SHAKE256>();
+  test_next_ct_matches_functor<uint64_t, randomshake::xof_kind_t::TURBOSHAKE128>();
+}
+
+TEST(RandomSHAKEConstantTime, Bounded_Sampling_Stays_Within_Interval)
+{
+  test_uniform_int_ct_fill_stays_within_interval<uint8_t>(97, 102);
+  test_uniform_int_ct_fill_stays_within_interval<uint8_t>(0, std::numeric_limits<uint8_t>::max());
+  test_uniform_int_ct_fill_stays_within_interval<uint16_t>(1, 6);
+  test_uniform_int_ct_fill_stays_within_interval<uint32_t>(0, 1'000'000'006);
+  test_uniform_int_ct_fill_stays_within_interval<uint64_t>(1'000, (1ULL << 63) + 12'345);
+  test_uniform_int_ct_fill_stays_within_interval<uint64_t>(0, std::numeric_limits<uint64_t>::max());
+  test_uniform_int_ct_fill_stays_within_interval<int8_t>(-100, 100);
+  test_uniform_int_ct_fill_stays_within_interval<int64_t>(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+}
+
+TEST(RandomSHAKEConstantTime, Bounded_Sampling_Maps_Two_Words_Per_Value)
+{
+  // W = 2^127 maps to the middle of the interval, W = 2^128 - 1 to its end and W = 0 to its beginning.
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{
+    .words = { 1ULL << 63, 0, std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max(), 0, 0 },
+  };
+
+  std::array<uint32_t, 3> values{};
+  randomshake::uniform_int_ct_fill(generator, std::span<uint32_t>(values), 10U, 19U);
+
+  EXPECT_EQ(values, (std::array<uint32_t, 3>{ 15, 19, 10 }));
+  EXPECT_EQ(generator.offset, 0U);
+
+  // Each of 10 values must be hit, when sampling many times.
+  randomshake::randomshake_t csprng(std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len>{});
+  std::array<bool, 10> is_hit{};
+  for (size_t i = 0; i < 1'024; i++) {
+    is_hit[randomshake::uniform_int_ct(csprng, size_t{ 0 }, 9)] = true;
+  }
+
+  EXPECT_TRUE(std::ranges::all_of(is_hit, [](const bool hit) { return hit; }));
+}
+
+TEST(RandomSHAKEConstantTime, Shuffle_Sorts_Values_By_Random_Keys)
+{
+  for (const size_t n : { 2UL, 3UL, 7UL, 64UL, 100UL, 1'000UL }) {
+    std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+    seed.fill(0xde);
+
+    randomshake::randomshake_t csprng(seed);
+
+    std::vector<uint64_t> keys(n, 0);
+    csprng.generate(std::span(keys));
+
+    std::vector<uint32_t> values(n, 0);
+    std::iota(values.begin(), values.end(), 0);
+
+    randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = keys };
+    randomshake::shuffle_ct(generator, std::span(values));
+
+    // Value i carried key i, so after shuffling, keys of values must be in ascending order.
+    EXPECT_TRUE(std::ranges::is_sorted(values, {}, [&](const uint32_t val) { return keys[val]; }));
+
+    std::ranges::sort(values);
+    std::vector<uint32_t> identity(n, 0);
+    std::iota(identity.begin(), identity.end(), 0);
+
+    EXPECT_EQ(values, identity);
+  }
+}
+
+TEST(RandomSHAKEConstantTime, Shuffle_Moves_Every_Value_Around)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  constexpr size_t n = 8;
+  std::array<std::array<size_t, n>, n> position_counts{};
+
+  for (size_t round = 0; round < 1'024; round++) {
+    std::array<uint8_t, n> values{};
+    std::iota(values.begin(), values.end(), 0);
+
+    randomshake::shuffle_ct(csprng, std::span<uint8_t>(values));
+
+    for (size_t pos = 0; pos < n; pos++) {
+      position_counts[values[pos]][pos]++;
+    }
+  }
+
+  for (const auto& counts : position_counts) {
+    EXPECT_TRUE(std::ranges::all_of(counts, [](const size_t count) { return count > 0; }));
+  }
+}
+
+TEST(RandomSHAKEConstantTime, Shuffle_Takes_Values_Without_Default_Constructor)
+{
+  struct tagged_value_t
+  {
+    uint32_t value;
+
+    explicit tagged_value_t(const uint32_t val)
+      : value(val)
+    {
+    }
+  };
+  static_assert(!std::is_default_constructible_v<tagged_value_t> && std::is_trivially_copyable_v<tagged_value_t>);
+
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<tagged_value_t> values{};
+  for (uint32_t i = 0; i < 100; i++) {
+    values.emplace_back(i);
+  }
+
+  randomshake::shuffle_ct(csprng, std::span(values));
+
+  std::vector<uint32_t> shuffled{};
+  std::ranges::transform(values, std::back_inserter(shuffled), [](const tagged_value_t& val) { return val.value; });
+  std::ranges::sort(shuffled);
+
+  std::vector<uint32_t> identity(values.size(), 0);
+  std::iota(identity.begin(), identity.end(), 0);
+
+  EXPECT_EQ(shuffled, identity);
+}
@@ -3,9 +3,12 @@
 #include "test_utils.hpp"
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <span>
 #include <vector>
 
 TEST(RandomSHAKE, Deterministic_CSPRNG_Using_Same_Seed_Produces_Eq_Output)
@@ -148,3 +151,147 @@ TEST(RandomSHAKE, Deterministic_CSPRNG_Oneshot_vs_Multishot_Squeezing)
 
   EXPECT_EQ(generated_bytes_oneshot, generated_bytes_multishot);
 }
+
+TEST(RandomSHAKE, Deterministic_CSPRNG_Bulk_Squeezing_Across_Ratchet_Period_Boundaries)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng_u8{ seed };
+  randomshake::randomshake_t csprng_bytes{ seed };
+
+  constexpr size_t RATCHET_PERIOD_BYTE_LEN = randomshake::xof_selector_t<randomshake::xof_kind_t::TURBOSHAKE256>::ratchet_period_byte_len;
+
+  // Squeeze lengths, chosen such that some requests start or end exactly at a ratchet period boundary,
+  // some span over multiple ratchet periods and some are served by the internal buffer alone.
+  constexpr std::array<size_t, 12> squeeze_byte_lens{
+    0, 1, RATCHET_PERIOD_BYTE_LEN - 1, RATCHET_PERIOD_BYTE_LEN, 3 * RATCHET_PERIOD_BYTE_LEN, 0, 17, 5 * RATCHET_PERIOD_BYTE_LEN + 7,
+    RATCHET_PERIOD_BYTE_LEN + 1, 2 * RATCHET_PERIOD_BYTE_LEN - 25, RATCHET_PERIOD_BYTE_LEN, 1
+  };
+
+  size_t total_byte_len = 0;
+  for (const auto byte_len : squeeze_byte_lens) {
+    total_byte_len += byte_len;
+  }
+
+  std::vector<uint8_t> generated_rand_u8(total_byte_len, 0x00);
+  std::vector<uint8_t> generated_byte_seq(total_byte_len, 0xff);
+
+  std::ranges::generate(generated_rand_u8, [&]() { return csprng_u8(); });
+
+  auto generated_byte_seq_span = std::span(generated_byte_seq);
+  size_t out_offset = 0;
+  for (const auto byte_len : squeeze_byte_lens) {
+    csprng_bytes.generate(generated_byte_seq_span.subspan(out_offset, byte_len));
+    out_offset += byte_len;
+  }
+
+  EXPECT_EQ(generated_rand_u8, generated_byte_seq);
+
+  // Both instances must have their internal buffer and ratchet schedule in sync, after all these calls.
+  EXPECT_EQ(csprng_u8(), csprng_bytes());
+}
+
+TEST(RandomSHAKE, Deterministic_CSPRNG_Batched_Typed_Generation_Matches_Scalar_Generation)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng_scalar{ seed };
+  randomshake::randomshake_t<uint8_t> csprng_batched{ seed };
+
+  constexpr size_t num_rand_u64_to_gen = GENERATED_RANDOM_BYTE_LEN / sizeof(uint64_t);
+
+  std::vector<uint64_t> generated_scalar(num_rand_u64_to_gen, 0x00);
+  std::vector<uint64_t> generated_batched(num_rand_u64_to_gen, 0xff);
+
+  std::ranges::generate(generated_scalar, [&]() { return csprng_scalar(); });
+  csprng_batched.generate(std::span(generated_batched));
+
+  EXPECT_EQ(generated_scalar, generated_batched);
+}
+
+TEST(RandomSHAKE, Deterministic_CSPRNG_Interleaved_Scalar_And_Batched_Generation_Keeps_Output_Stream_Intact)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint8_t> csprng_bytes{ seed };
+  randomshake::randomshake_t<uint64_t> csprng_mixed{ seed };
+
+  std::vector<uint8_t> expected(GENERATED_RANDOM_BYTE_LEN, 0x00);
+  csprng_bytes.generate(expected);
+
+  std::vector<uint8_t> computed{};
+  computed.reserve(GENERATED_RANDOM_BYTE_LEN);
+
+  const auto append = [&](const auto& values) {
+    const auto bytes = std::as_bytes(std::span(values));
+    std::ranges::transform(bytes, std::back_inserter(computed), [](const std::byte b) { return std::to_integer<uint8_t>(b); });
+  };
+
+  // Odd-length byte squeezes leave the buffer at offsets, which are not multiple of `sizeof(uint64_t)`, so that
+  // following scalar calls have to read across ratchet period boundaries.
+  size_t round_idx = 0;
+  while (computed.size() + 1'024 <= GENERATED_RANDOM_BYTE_LEN) {
+    std::vector<uint8_t> u8s(3 + (round_idx % 11), 0x00);
+    csprng_mixed.generate(u8s);
+    append(u8s);
+
+    const std::array<uint64_t, 1> u64{ csprng_mixed() };
+    append(u64);
+
+    std::vector<uint32_t> u32s(13 + (round_idx % 97), 0x00);
+    csprng_mixed.generate(std::span(u32s));
+    append(u32s);
+
+    std::vector<uint16_t> u16s(5 + (round_idx % 7), 0x00);
+    csprng_mixed.generate(std::span(u16s));
+    append(u16s);
+
+    round_idx++;
+  }
+
+  EXPECT_TRUE(std::ranges::equal(computed, std::span(expected).first(computed.size())));
+}
+
+namespace {
+
+/**
+ * First 32 -bytes of output of RandomSHAKE CSPRNG, seeded with `seed_byte_len` -bytes, all set to 0xde. These are the first
+ * 32 -bytes of XOF(SEED), as no ratcheting happens before a full ratchet period is squeezed, computed independently of this
+ * library.
+ */
+template<randomshake::xof_kind_t xof_kind>
+void
+test_deterministic_csprng_known_answer(std::span<const uint8_t, 32> expected)
+{
+  std::array<uint8_t, randomshake::randomshake_t<uint8_t, xof_kind>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint8_t, xof_kind> csprng(seed);
+
+  std::array<uint8_t, 32> computed{};
+  csprng.generate(computed);
+
+  EXPECT_TRUE(std::ranges::equal(computed, expected));
+}
+
+}
+
+TEST(RandomSHAKE, Deterministic_CSPRNG_Known_Answer_Tests)
+{
+  constexpr std::array<uint8_t, 32> SHAKE256_KAT = { 0x8d, 0x0b, 0x62, 0x4d, 0x4d, 0x3f, 0xd0, 0xf1, 0x11, 0xa8, 0xfb, 0x93, 0x96, 0x1b, 0xc6, 0x9a,
+                                                     0xc8, 0x26, 0x1f, 0xec, 0x4c, 0x8b, 0x2d, 0xd2, 0x80, 0x5a, 0xbf, 0x93, 0x0a, 0x18, 0x49, 0x5b };
+  constexpr std::array<uint8_t, 32> TURBOSHAKE256_KAT = { 0x91, 0x4c, 0x3d, 0x3b, 0x79, 0xe1, 0xac, 0xd7, 0xb1, 0x04, 0x7b, 0xf5, 0x5e, 0x26, 0xac, 0x20,
+                                                          0x61, 0x63, 0x11, 0x45, 0xca, 0x2d, 0x65, 0x9e, 0x41, 0xfd, 0x4f, 0x1f, 0x6b, 0x81, 0xcf, 0xc7 };
+  constexpr std::array<uint8_t, 32> SHAKE128_KAT = { 0x60, 0xdd, 0xc1, 0xed, 0x6f, 0x01, 0x9f, 0x85, 0x80, 0x74, 0x51, 0x11, 0x0b, 0xca, 0x5c, 0xbb,
+                                                     0x5e, 0x16, 0xf7, 0xe9, 0x3b, 0x31, 0xfe, 0x81, 0xff, 0xe5, 0x76, 0x98, 0xd2, 0x79, 0x02, 0xfe };
+  constexpr std::array<uint8_t, 32> TURBOSHAKE128_KAT = { 0x41, 0x00, 0x1d, 0x57, 0x03, 0xa1, 0x9e, 0xff, 0xba, 0xd3, 0xf4, 0xb2, 0x0e, 0xab, 0x8b, 0x2a,
+                                                          0xcd, 0x98, 0x15, 0x1c, 0x50, 0x48, 0xb7, 0x48, 0x72, 0xd6, 0x7a, 0xc1, 0x58, 0xd2, 0xaf, 0xc1 };
+
+  test_deterministic_csprng_known_answer<randomshake::xof_kind_t::SHAKE256>(SHAKE256_KAT);
+  test_deterministic_csprng_known_answer<randomshake::xof_kind_t::TURBOSHAKE256>(TURBOSHAKE256_KAT);
+  test_deterministic_csprng_known_answer<randomshake::xof_kind_t::SHAKE128>(SHAKE128_KAT);
+  test_deterministic_csprng_known_answer<randomshake::xof_kind_t::TURBOSHAKE128>(TURBOSHAKE128_KAT);
+}
@@ -0,0 +1,86 @@
+#include "randomshake/entropy_source.hpp"
+#include "randomshake/randomshake.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Deterministic "entropy source", handing out 0, 1, 2, ... for testing how CSPRNG consumes entropy sources.
+struct counting_entropy_source_t
+{
+  uint8_t next_byte = 0;
+
+  void fill(std::span<uint8_t> output)
+  {
+    for (auto& byte : output) {
+      byte = next_byte++;
+    }
+  }
+};
+
+template<typename source_t>
+void
+test_entropy_source_produces_ne_output()
+{
+  // Odd lengths, longer than what a single `getentropy` call can serve, to exercise both chunking and tail handling.
+  for (const size_t output_byte_len : { size_t{ 1 }, size_t{ 13 }, size_t{ 136 }, size_t{ 1'001 } }) {
+    source_t source{};
+
+    std::vector<uint8_t> output_a(output_byte_len, 0x00);
+    std::vector<uint8_t> output_b(output_byte_len, 0x00);
+    source.fill(output_a);
+    source.fill(output_b);
+
+    // Two 13+ -bytes long non-deterministic outputs collide with negligible probability.
+    if (output_byte_len > 8) {
+      EXPECT_NE(output_a, output_b);
+      EXPECT_NE(output_a, std::vector<uint8_t>(output_byte_len, 0x00));
+    }
+  }
+}
+
+}
+
+TEST(RandomSHAKEEntropySource, Entropy_Sources_Produce_Ne_Output)
+{
+  test_entropy_source_produces_ne_output<randomshake::os_entropy_source_t>();
+  test_entropy_source_produces_ne_output<randomshake::random_device_entropy_source_t>();
+  test_entropy_source_produces_ne_output<randomshake::hardware_mixed_entropy_source_t<>>();
+}
+
+TEST(RandomSHAKEEntropySource, CSPRNG_Seeded_From_Entropy_Source_Matches_Explicit_Seed)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  counting_entropy_source_t{}.fill(seed);
+
+  randomshake::randomshake_t csprng_a(counting_entropy_source_t{});
+  randomshake::randomshake_t csprng_b(seed);
+
+  std::array<uint8_t, 1'024> rand_bytes_a{};
+  std::array<uint8_t, 1'024> rand_bytes_b{};
+  csprng_a.generate(rand_bytes_a);
+  csprng_b.generate(rand_bytes_b);
+
+  EXPECT_EQ(rand_bytes_a, rand_bytes_b);
+}
+
+TEST(RandomSHAKEEntropySource, Non_Deterministic_CSPRNGs_Produce_Ne_Output)
+{
+  randomshake::randomshake_t csprng_a;
+  randomshake::randomshake_t csprng_b(randomshake::random_device_entropy_source_t{});
+  randomshake::randomshake_t csprng_c(randomshake::hardware_mixed_entropy_source_t{});
+
+  std::array<uint8_t, 64> rand_bytes_a{};
+  std::array<uint8_t, 64> rand_bytes_b{};
+  std::array<uint8_t, 64> rand_bytes_c{};
+  csprng_a.generate(rand_bytes_a);
+  csprng_b.generate(rand_bytes_b);
+  csprng_c.generate(rand_bytes_c);
+
+  EXPECT_NE(rand_bytes_a, rand_bytes_b);
+  EXPECT_NE(rand_bytes_a, rand_bytes_c);
+  EXPECT_NE(rand_bytes_b, rand_bytes_c);
+}
@@ -0,0 +1,126 @@
+#include "randomshake/generate_parallel.hpp"
+#include "randomshake/randomshake.hpp"
+#include "test_consts.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Runs all tasks one after another, on the calling thread, in reverse index order.
+constexpr auto reverse_sequential_executor = [](const size_t num_tasks, const std::function<void(size_t)>& task) {
+  for (size_t task_idx = num_tasks; task_idx > 0; task_idx--) {
+    task(task_idx - 1);
+  }
+};
+
+template<randomshake::xof_kind_t xof_kind>
+void
+test_generate_parallel_is_independent_of_executor()
+{
+  using csprng_t = randomshake::randomshake_t<uint8_t, xof_kind>;
+  constexpr size_t chunk_byte_len = 4'096 + 3;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::vector<uint8_t> expected(GENERATED_RANDOM_BYTE_LEN, 0x00);
+  {
+    csprng_t csprng(seed);
+    randomshake::generate_parallel(csprng, std::span(expected), reverse_sequential_executor, chunk_byte_len);
+  }
+
+  for (const size_t num_threads : { size_t{ 0 }, size_t{ 1 }, size_t{ 2 }, size_t{ 7 } }) {
+    csprng_t csprng(seed);
+
+    std::vector<uint8_t> computed(expected.size(), 0x00);
+    randomshake::generate_parallel(csprng, std::span(computed), randomshake::std_thread_executor_t{ num_threads }, chunk_byte_len);
+
+    EXPECT_EQ(computed, expected);
+  }
+}
+
+template<randomshake::xof_kind_t xof_kind>
+void
+test_generate_parallel_chunks_are_child_xof_outputs()
+{
+  using csprng_t = randomshake::randomshake_t<uint8_t, xof_kind>;
+  constexpr size_t chunk_byte_len = 1'000;
+  constexpr size_t output_byte_len = 5 * chunk_byte_len + 17;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  csprng_t csprng_a(seed);
+  csprng_t csprng_b(seed);
+
+  std::vector<uint8_t> computed(output_byte_len, 0x00);
+  randomshake::generate_parallel(csprng_a, std::span(computed), randomshake::std_thread_executor_t{}, chunk_byte_len);
+
+  // Reproduce the output, by squeezing the child key and driving each child XOF instance by hand.
+  std::array<uint8_t, csprng_t::seed_byte_len> child_key{};
+  csprng_b.generate(child_key);
+
+  std::vector<uint8_t> expected(output_byte_len, 0x00);
+  auto expected_span = std::span(expected);
+
+  for (uint64_t chunk_idx = 0; chunk_idx * chunk_byte_len < output_byte_len; chunk_idx++) {
+    std::array<uint8_t, sizeof(chunk_idx)> chunk_idx_bytes{};
+    std::memcpy(chunk_idx_bytes.data(), &chunk_idx, sizeof(chunk_idx));
+
+    typename randomshake::xof_selector_t<xof_kind>::type child{};
+    child.reset();
+    child.absorb(randomshake::GENERATE_PARALLEL_DOMAIN);
+    child.absorb(child_key);
+    child.absorb(chunk_idx_bytes);
+    child.finalize();
+
+    const size_t chunk_offset = chunk_idx * chunk_byte_len;
+    child.squeeze(expected_span.subspan(chunk_offset, std::min(chunk_byte_len, output_byte_len - chunk_offset)));
+  }
+
+  EXPECT_EQ(computed, expected);
+
+  // Parent CSPRNG must have advanced by exactly the child key length.
+  std::array<uint8_t, 64> next_a{};
+  std::array<uint8_t, 64> next_b{};
+  csprng_a.generate(next_a);
+  csprng_b.generate(next_b);
+
+  EXPECT_EQ(next_a, next_b);
+}
+
+}
+
+TEST(RandomSHAKEGenerateParallel, Output_Is_Independent_Of_Executor)
+{
+  test_generate_parallel_is_independent_of_executor<randomshake::xof_kind_t::SHAKE256>();
+  test_generate_parallel_is_independent_of_executor<randomshake::xof_kind_t::TURBOSHAKE256>();
+}
+
+TEST(RandomSHAKEGenerateParallel, Chunks_Are_Child_XOF_Outputs)
+{
+  test_generate_parallel_chunks_are_child_xof_outputs<randomshake::xof_kind_t::SHAKE256>();
+  test_generate_parallel_chunks_are_child_xof_outputs<randomshake::xof_kind_t::TURBOSHAKE256>();
+}
+
+TEST(RandomSHAKEGenerateParallel, Consecutive_Calls_Produce_Ne_Output)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<uint8_t> rand_bytes_a(GENERATED_RANDOM_BYTE_LEN / 16, 0x00);
+  std::vector<uint8_t> rand_bytes_b(rand_bytes_a.size(), 0x00);
+
+  randomshake::generate_parallel(csprng, std::span(rand_bytes_a));
+  randomshake::generate_parallel(csprng, std::span(rand_bytes_b));
+
+  EXPECT_NE(rand_bytes_a, rand_bytes_b);
+}
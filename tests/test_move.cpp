@@ -0,0 +1,142 @@
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using csprng_t = randomshake::randomshake_t<uint64_t>;
+
+static_assert(!std::is_copy_constructible_v<csprng_t> && !std::is_copy_assignable_v<csprng_t>, "RandomSHAKE CSPRNG must not be copyable !");
+static_assert(std::is_nothrow_move_constructible_v<csprng_t> && std::is_nothrow_move_assignable_v<csprng_t>, "RandomSHAKE CSPRNG must be movable !");
+
+static_assert(std::is_standard_layout_v<csprng_t>, "RandomSHAKE CSPRNG must be standard layout, for inspecting its state !");
+
+// Checks that both the lanes of the XOF state and the buffer of squeezed bytes, of a moved-from CSPRNG instance, are zeroized.
+void
+expect_zeroized(const csprng_t& csprng)
+{
+  using xof_t = randomshake::xof_selector_t<randomshake::xof_kind_t::TURBOSHAKE256>::type;
+
+  // XOF state, starting with Keccak-p[1600] lanes, is the first member, immediately followed by the buffer.
+  const auto object_repr = std::span(reinterpret_cast<const uint8_t*>(&csprng), sizeof(csprng)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto keccak_state = object_repr.first(randomshake::EXPORTED_KECCAK_STATE_BYTE_LEN);
+  const auto buffer = object_repr.subspan(sizeof(xof_t), csprng_t::ratchet_period_byte_len);
+
+  EXPECT_TRUE(std::ranges::all_of(keccak_state, [](const uint8_t byte) { return byte == 0; }));
+  EXPECT_TRUE(std::ranges::all_of(buffer, [](const uint8_t byte) { return byte == 0; }));
+}
+
+}
+
+TEST(RandomSHAKEMove, Moved_To_Instance_Continues_Output_Stream)
+{
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  // Move in the middle of the buffer, exactly at the end of it and across ratchet periods.
+  for (const size_t num_consumed_bytes : { size_t{ 13 }, csprng_t::ratchet_period_byte_len, 3 * csprng_t::ratchet_period_byte_len + 5 }) {
+    csprng_t reference(seed);
+    csprng_t csprng(seed);
+
+    std::vector<uint8_t> consumed(num_consumed_bytes, 0);
+    reference.generate(consumed);
+    csprng.generate(consumed);
+
+    csprng_t moved_to(std::move(csprng));
+    expect_zeroized(csprng); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+
+    std::vector<uint64_t> expected(2 * csprng_t::ratchet_period_byte_len / sizeof(uint64_t) + 3, 0);
+    std::vector<uint64_t> computed(expected.size(), 0);
+
+    std::ranges::generate(expected, [&]() { return reference(); });
+    std::ranges::generate(computed, [&]() { return moved_to(); });
+
+    EXPECT_EQ(computed, expected);
+  }
+}
+
+TEST(RandomSHAKEMove, Move_Assignment_Replaces_Output_Stream)
+{
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::array<uint8_t, csprng_t::seed_byte_len> other_seed{};
+  other_seed.fill(0xad);
+
+  csprng_t reference(seed);
+  csprng_t csprng(seed);
+  csprng_t assigned_to(other_seed);
+
+  std::array<uint8_t, 37> consumed{};
+  reference.generate(consumed);
+  csprng.generate(consumed);
+
+  assigned_to = std::move(csprng);
+  expect_zeroized(csprng); // NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+
+  std::vector<uint8_t> expected(csprng_t::ratchet_period_byte_len + 11, 0);
+  std::vector<uint8_t> computed(expected.size(), 0);
+  reference.generate(expected);
+  assigned_to.generate(computed);
+
+  EXPECT_EQ(computed, expected);
+}
+
+TEST(RandomSHAKEMove, Instances_Can_Live_In_Vector)
+{
+  constexpr size_t num_instances = 16;
+
+  // Keep reallocating, by not reserving capacity upfront, so that instances get relocated a few times.
+  std::vector<csprng_t> csprngs;
+  for (size_t i = 0; i < num_instances; i++) {
+    std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+    seed.fill(static_cast<uint8_t>(i));
+
+    csprngs.emplace_back(seed);
+    std::ignore = csprngs.back()();
+  }
+
+  for (size_t i = 0; i < num_instances; i++) {
+    std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+    seed.fill(static_cast<uint8_t>(i));
+
+    csprng_t reference(seed);
+    std::ignore = reference();
+
+    EXPECT_EQ(csprngs[i](), reference());
+  }
+}
+
+TEST(RandomSHAKEMoveDeathTest, Using_Moved_From_Instance_Aborts)
+{
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  csprng_t csprng(seed);
+  csprng_t moved_to(std::move(csprng));
+
+  std::array<uint8_t, 16> output{};
+  std::array<uint8_t, csprng_t::exported_state_max_byte_len> exported{};
+
+  // NOLINTBEGIN(bugprone-use-after-move,hicpp-invalid-access-moved)
+  EXPECT_DEATH(std::ignore = csprng(), "");
+  EXPECT_DEATH(csprng.generate(output), "");
+  EXPECT_DEATH(csprng.reseed(output), "");
+  EXPECT_DEATH(std::ignore = csprng.export_state(exported), "");
+
+  // Assigning to it, or importing a state into it, makes it usable again.
+  csprng = std::move(moved_to);
+  std::ignore = csprng();
+
+  const size_t exported_byte_len = csprng.export_state(exported);
+  EXPECT_TRUE(moved_to.import_state(std::span(exported).first(exported_byte_len)));
+  EXPECT_EQ(moved_to(), csprng());
+  // NOLINTEND(bugprone-use-after-move,hicpp-invalid-access-moved)
+}
@@ -0,0 +1,127 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_multilane.hpp"
+#include "test_consts.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+/**
+ * Reproduces the output stream of a multi-lane RandomSHAKE CSPRNG, by driving each lane's XOF instance separately,
+ * and then stitching their ratchet period sized chunks together in lane order.
+ */
+template<randomshake::xof_kind_t xof_kind, size_t num_lanes, size_t ratchet_period_block_count>
+std::vector<uint8_t>
+generate_multilane_stream_lane_by_lane(std::span<const uint8_t, randomshake::xof_selector_t<xof_kind>::seed_byte_len> seed, const size_t num_ratchet_periods)
+{
+  constexpr size_t lane_period_byte_len = randomshake::randomshake_multilane_t<uint8_t, xof_kind, num_lanes, ratchet_period_block_count>::lane_period_byte_len;
+
+  std::vector<uint8_t> stream(num_ratchet_periods * num_lanes * lane_period_byte_len, 0x00);
+  auto stream_span = std::span(stream);
+
+  for (size_t lane_idx = 0; lane_idx < num_lanes; lane_idx++) {
+    const std::array<uint8_t, 1> lane_idx_byte{ static_cast<uint8_t>(lane_idx) };
+
+    typename randomshake::xof_selector_t<xof_kind>::type lane{};
+    lane.reset();
+    lane.absorb(seed);
+    lane.absorb(lane_idx_byte);
+    lane.finalize();
+
+    for (size_t period_idx = 0; period_idx < num_ratchet_periods; period_idx++) {
+      if (period_idx > 0) {
+        lane.ratchet(randomshake::xof_selector_t<xof_kind>::ratchet_byte_len);
+      }
+
+      lane.squeeze(stream_span.subspan((period_idx * num_lanes + lane_idx) * lane_period_byte_len, lane_period_byte_len));
+    }
+  }
+
+  return stream;
+}
+
+template<randomshake::xof_kind_t xof_kind, size_t num_lanes, size_t ratchet_period_block_count = randomshake::default_ratchet_period_block_count<xof_kind>>
+void
+test_multilane_csprng_stitches_lanes_in_order()
+{
+  std::array<uint8_t, randomshake::xof_selector_t<xof_kind>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  constexpr size_t num_ratchet_periods = 3;
+  const auto expected = generate_multilane_stream_lane_by_lane<xof_kind, num_lanes, ratchet_period_block_count>(seed, num_ratchet_periods);
+
+  // Squeeze the stream in uneven pieces, so that both the buffered and the direct-to-output paths of `generate` are exercised.
+  randomshake::randomshake_multilane_t<uint8_t, xof_kind, num_lanes, ratchet_period_block_count> csprng(seed);
+  std::vector<uint8_t> computed(expected.size(), 0x00);
+  auto computed_span = std::span(computed);
+
+  constexpr size_t first_piece_byte_len = 17;
+  csprng.generate(computed_span.first(first_piece_byte_len));
+  csprng.generate(computed_span.subspan(first_piece_byte_len));
+
+  EXPECT_EQ(expected, computed);
+
+  randomshake::randomshake_multilane_t<uint8_t, xof_kind, num_lanes, ratchet_period_block_count> csprng_whole(seed);
+  std::vector<uint8_t> computed_whole(expected.size(), 0x00);
+  csprng_whole.generate(computed_whole);
+
+  EXPECT_EQ(expected, computed_whole);
+}
+
+}
+
+TEST(RandomSHAKEMultiLane, Deterministic_CSPRNG_Stitches_Lanes_In_Order)
+{
+  test_multilane_csprng_stitches_lanes_in_order<randomshake::xof_kind_t::SHAKE256, 4>();
+  test_multilane_csprng_stitches_lanes_in_order<randomshake::xof_kind_t::TURBOSHAKE256, 4>();
+  test_multilane_csprng_stitches_lanes_in_order<randomshake::xof_kind_t::SHAKE256, 8>();
+  test_multilane_csprng_stitches_lanes_in_order<randomshake::xof_kind_t::TURBOSHAKE256, 8>();
+  test_multilane_csprng_stitches_lanes_in_order<randomshake::xof_kind_t::SHAKE128, 4>();
+  test_multilane_csprng_stitches_lanes_in_order<randomshake::xof_kind_t::TURBOSHAKE128, 8>();
+  test_multilane_csprng_stitches_lanes_in_order<randomshake::xof_kind_t::TURBOSHAKE256, 3, 1>();
+  test_multilane_csprng_stitches_lanes_in_order<randomshake::xof_kind_t::SHAKE256, 5, 1>();
+}
+
+TEST(RandomSHAKEMultiLane, Deterministic_CSPRNG_Using_Same_Seed_With_Diff_Public_API)
+{
+  std::array<uint8_t, randomshake::randomshake_x8_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_x8_t<uint64_t> csprng_u64{ seed };
+  randomshake::randomshake_x8_t csprng_bytes{ seed };
+
+  std::vector<uint64_t> generated_rand_u64(GENERATED_RANDOM_BYTE_LEN / sizeof(uint64_t), 0x00);
+  std::vector<uint8_t> generated_byte_seq(GENERATED_RANDOM_BYTE_LEN, 0xff);
+
+  std::ranges::generate(generated_rand_u64, [&]() { return csprng_u64(); });
+  csprng_bytes.generate(generated_byte_seq);
+
+  EXPECT_EQ(0, std::memcmp(generated_rand_u64.data(), generated_byte_seq.data(), GENERATED_RANDOM_BYTE_LEN));
+}
+
+TEST(RandomSHAKEMultiLane, Deterministic_CSPRNG_Output_Differs_From_Single_Lane_CSPRNG)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng_x1{ seed };
+  randomshake::randomshake_x4_t csprng_x4{ seed };
+  randomshake::randomshake_x8_t csprng_x8{ seed };
+
+  std::vector<uint8_t> rand_bytes_x1(GENERATED_RANDOM_BYTE_LEN, 0x00);
+  std::vector<uint8_t> rand_bytes_x4(GENERATED_RANDOM_BYTE_LEN, 0x00);
+  std::vector<uint8_t> rand_bytes_x8(GENERATED_RANDOM_BYTE_LEN, 0x00);
+
+  csprng_x1.generate(rand_bytes_x1);
+  csprng_x4.generate(rand_bytes_x4);
+  csprng_x8.generate(rand_bytes_x8);
+
+  EXPECT_NE(rand_bytes_x1, rand_bytes_x4);
+  EXPECT_NE(rand_bytes_x1, rand_bytes_x8);
+  EXPECT_NE(rand_bytes_x4, rand_bytes_x8);
+}
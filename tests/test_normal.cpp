@@ -0,0 +1,137 @@
+#include "randomshake/normal.hpp"
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Computes sample mean and (biased) sample variance of given values.
+template<typename T>
+std::pair<double, double>
+compute_mean_and_variance(const std::vector<T>& values)
+{
+  const auto num_values = static_cast<double>(values.size());
+
+  const double mean =
+    std::accumulate(values.begin(), values.end(), 0., [](const double acc, const T val) { return acc + static_cast<double>(val); }) / num_values;
+  const double variance = std::accumulate(values.begin(),
+                                          values.end(),
+                                          0.,
+                                          [mean](const double acc, const T val) {
+                                            const double diff = static_cast<double>(val) - mean;
+                                            return acc + diff * diff;
+                                          }) /
+                          num_values;
+
+  return { mean, variance };
+}
+
+}
+
+TEST(RandomSHAKENormal, Ziggurat_Table_Layers_Have_Equal_Area)
+{
+  const auto& table = randomshake::ziggurat_normal_table();
+
+  EXPECT_EQ(table.x[1], randomshake::ziggurat_normal_table_t::R);
+  EXPECT_EQ(table.x[randomshake::ziggurat_normal_table_t::NUM_LAYERS], 0.);
+  EXPECT_TRUE(std::ranges::is_sorted(table.x, std::ranges::greater{}));
+
+  for (size_t i = 1; i < randomshake::ziggurat_normal_table_t::NUM_LAYERS; i++) {
+    const double area = table.x[i] * (table.f[i + 1] - table.f[i]);
+    EXPECT_NEAR(area, randomshake::ziggurat_normal_table_t::V, 1e-9);
+  }
+}
+
+TEST(RandomSHAKENormal, Sampled_Values_Follow_Standard_Normal_Distribution)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  constexpr size_t NUM_VALUES = 1'000'000;
+
+  std::vector<double> values(NUM_VALUES, 0.);
+  randomshake::normal_fill(csprng, std::span(values));
+
+  const auto [mean, variance] = compute_mean_and_variance(values);
+  EXPECT_NEAR(mean, 0., 0.01);
+  EXPECT_NEAR(variance, 1., 0.01);
+
+  // Pr[|X| < 1] = 0.6827 and Pr[|X| > R] = 2.58e-4, for a standard normal random variable X.
+  const auto within_one_stddev = std::ranges::count_if(values, [](const double val) { return std::abs(val) < 1.; });
+  const auto in_tail = std::ranges::count_if(values, [](const double val) { return std::abs(val) > randomshake::ziggurat_normal_table_t::R; });
+
+  EXPECT_NEAR(static_cast<double>(within_one_stddev) / static_cast<double>(NUM_VALUES), 0.6827, 0.003);
+  EXPECT_NEAR(static_cast<double>(in_tail) / static_cast<double>(NUM_VALUES), 2.58e-4, 0.8e-4);
+}
+
+TEST(RandomSHAKENormal, Sampled_Values_Are_Shifted_And_Scaled)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng_a(seed);
+  randomshake::randomshake_t csprng_b(seed);
+
+  constexpr size_t NUM_VALUES = 100'000;
+
+  std::vector<float> standard(NUM_VALUES, 0.F);
+  std::vector<float> shifted_scaled(NUM_VALUES, 0.F);
+
+  randomshake::normal_fill(csprng_a, std::span(standard));
+  randomshake::normal_fill(csprng_b, std::span(shifted_scaled), 10.F, 2.F);
+
+  for (size_t i = 0; i < NUM_VALUES; i++) {
+    EXPECT_FLOAT_EQ(shifted_scaled[i], 10.F + 2.F * standard[i]);
+  }
+}
+
+TEST(RandomSHAKENormal, Discrete_Gaussian_Samples_Have_Expected_Moments)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  constexpr double SIGMA = 3.2;
+  constexpr size_t NUM_VALUES = 1'000'000;
+
+  const randomshake::discrete_gaussian_cdt_t sampler(SIGMA);
+  EXPECT_EQ(sampler.max_abs_value(), 32U);
+
+  std::vector<int32_t> values(NUM_VALUES, 0);
+  sampler.fill(csprng, std::span(values));
+
+  const auto [mean, variance] = compute_mean_and_variance(values);
+  EXPECT_NEAR(mean, 0., 0.02);
+  EXPECT_NEAR(variance, SIGMA * SIGMA, 0.05);
+
+  const auto max_abs = static_cast<int32_t>(sampler.max_abs_value());
+  EXPECT_TRUE(std::ranges::all_of(values, [&](const int32_t val) { return std::abs(val) <= max_abs; }));
+}
+
+TEST(RandomSHAKENormal, Discrete_Gaussian_Sampler_Maps_Words_As_Documented)
+{
+  const randomshake::discrete_gaussian_cdt_t sampler(2.);
+
+  // Lowest bit chooses sign, while remaining 63 bits are compared against cumulative distribution table.
+  EXPECT_EQ(sampler.sample(0), 0);
+  EXPECT_EQ(sampler.sample(1), 0);
+
+  // Largest 63-bit value maps to the largest |X|, having non-negligible probability mass, with 63-bit precision.
+  const auto largest_pos = sampler.sample(std::numeric_limits<uint64_t>::max() - 1);
+  const auto largest_neg = sampler.sample(std::numeric_limits<uint64_t>::max());
+
+  EXPECT_GT(largest_pos, 0);
+  EXPECT_LE(largest_pos, static_cast<int64_t>(sampler.max_abs_value()));
+  EXPECT_EQ(largest_neg, -largest_pos);
+}
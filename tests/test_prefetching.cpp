@@ -0,0 +1,137 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_prefetching.hpp"
+#include "test_consts.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+/**
+ * Squeezes bytes from a prefetching CSPRNG, in many differently sized requests, some of them crossing slot boundaries, and
+ * checks that the output stream is same as `randomshake_t`'s output stream, for the same seed.
+ */
+template<randomshake::xof_kind_t xof_kind, size_t ratchet_period_block_count = randomshake::default_ratchet_period_block_count<xof_kind>>
+void
+test_prefetching_csprng_produces_same_output_as_randomshake(const randomshake::refill_mode_t refill_mode)
+{
+  using prefetching_csprng_t = randomshake::randomshake_prefetching_t<uint8_t, xof_kind, 4, ratchet_period_block_count>;
+
+  std::array<uint8_t, prefetching_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::vector<uint8_t> expected(GENERATED_RANDOM_BYTE_LEN, 0x00);
+  randomshake::randomshake_t<uint8_t, xof_kind, ratchet_period_block_count> csprng(seed);
+  csprng.generate(expected);
+
+  std::vector<uint8_t> computed(GENERATED_RANDOM_BYTE_LEN, 0xff);
+  prefetching_csprng_t prefetching_csprng(seed, refill_mode);
+
+  auto computed_span = std::span(computed);
+  size_t out_offset = 0;
+  size_t request_byte_len = 1;
+
+  while (out_offset < computed_span.size()) {
+    const size_t num_bytes = std::min(request_byte_len, computed_span.size() - out_offset);
+    if (num_bytes == 1) {
+      computed_span[out_offset] = prefetching_csprng();
+    } else {
+      prefetching_csprng.generate(computed_span.subspan(out_offset, num_bytes));
+    }
+
+    if (refill_mode == randomshake::refill_mode_t::MANUAL && (request_byte_len % 3 == 0)) {
+      static_cast<void>(prefetching_csprng.refill());
+    }
+
+    out_offset += num_bytes;
+    request_byte_len = (request_byte_len * 7 + 5) % (3 * prefetching_csprng_t::slot_byte_len);
+  }
+
+  EXPECT_EQ(computed, expected);
+}
+
+}
+
+TEST(RandomSHAKEPrefetching, Background_Thread_Refilling_Produces_Same_Output_As_RandomSHAKE)
+{
+  test_prefetching_csprng_produces_same_output_as_randomshake<randomshake::xof_kind_t::SHAKE256>(randomshake::refill_mode_t::BACKGROUND_THREAD);
+  test_prefetching_csprng_produces_same_output_as_randomshake<randomshake::xof_kind_t::TURBOSHAKE256>(randomshake::refill_mode_t::BACKGROUND_THREAD);
+}
+
+TEST(RandomSHAKEPrefetching, Manual_Refilling_Produces_Same_Output_As_RandomSHAKE)
+{
+  test_prefetching_csprng_produces_same_output_as_randomshake<randomshake::xof_kind_t::SHAKE256>(randomshake::refill_mode_t::MANUAL);
+  test_prefetching_csprng_produces_same_output_as_randomshake<randomshake::xof_kind_t::TURBOSHAKE256>(randomshake::refill_mode_t::MANUAL);
+  test_prefetching_csprng_produces_same_output_as_randomshake<randomshake::xof_kind_t::TURBOSHAKE256, 1>(randomshake::refill_mode_t::MANUAL);
+  test_prefetching_csprng_produces_same_output_as_randomshake<randomshake::xof_kind_t::SHAKE128, 3>(randomshake::refill_mode_t::BACKGROUND_THREAD);
+}
+
+TEST(RandomSHAKEPrefetching, Refill_Fills_Only_Consumed_Slots)
+{
+  constexpr size_t num_slots = 4;
+  using prefetching_csprng_t = randomshake::randomshake_prefetching_t<uint8_t, randomshake::xof_kind_t::TURBOSHAKE256, num_slots>;
+
+  std::array<uint8_t, prefetching_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  prefetching_csprng_t csprng(seed, randomshake::refill_mode_t::MANUAL);
+  EXPECT_EQ(csprng.refill(), 0U);
+
+  // Consumes two and a half slots. Only the two fully consumed ones are free.
+  std::vector<uint8_t> rand_bytes(2 * prefetching_csprng_t::slot_byte_len + prefetching_csprng_t::slot_byte_len / 2, 0);
+  csprng.generate(rand_bytes);
+
+  EXPECT_EQ(csprng.refill(), 2U);
+  EXPECT_EQ(csprng.refill(), 0U);
+
+  // Consuming more than all slots, without refilling, falls back to refilling in the calling thread. Ends at a slot boundary.
+  rand_bytes.resize(num_slots * prefetching_csprng_t::slot_byte_len + prefetching_csprng_t::slot_byte_len / 2);
+  csprng.generate(rand_bytes);
+
+  EXPECT_EQ(csprng.refill(), num_slots);
+}
+
+TEST(RandomSHAKEPrefetching, Consumed_Slots_Are_Zeroized_Before_Refill)
+{
+  using prefetching_csprng_t = randomshake::randomshake_prefetching_t<uint8_t>;
+
+  std::array<uint8_t, prefetching_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  prefetching_csprng_t csprng(seed, randomshake::refill_mode_t::MANUAL);
+
+  // Consumes first two slots, but doesn't refill them, so their past output must not be found anywhere in the slots. Only the
+  // second slot is looked for, as the first one is copied out of the buffer of the underlying `randomshake_t`, where it stays,
+  // until that buffer is refilled. Whole ratchet periods, like the second slot, are squeezed straight into the slot.
+  std::vector<uint8_t> rand_bytes(2 * prefetching_csprng_t::slot_byte_len, 0);
+  csprng.generate(rand_bytes);
+
+  const auto csprng_bytes = std::span(reinterpret_cast<const uint8_t*>(&csprng), sizeof(csprng)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  for (size_t offset = prefetching_csprng_t::slot_byte_len; offset < rand_bytes.size(); offset += 32) {
+    const auto needle = std::span(rand_bytes).subspan(offset, 32);
+    EXPECT_TRUE(std::ranges::search(csprng_bytes, needle).empty());
+  }
+}
+
+TEST(RandomSHAKEPrefetching, Typed_Generation_Produces_Same_Output_As_Byte_Generation)
+{
+  using prefetching_csprng_t = randomshake::randomshake_prefetching_t<uint64_t>;
+
+  std::array<uint8_t, prefetching_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::vector<uint8_t> rand_bytes(GENERATED_RANDOM_BYTE_LEN, 0x00);
+  prefetching_csprng_t csprng_a(seed);
+  csprng_a.generate(rand_bytes);
+
+  std::vector<uint64_t> rand_words(GENERATED_RANDOM_BYTE_LEN / sizeof(uint64_t), 0);
+  prefetching_csprng_t csprng_b(seed);
+  rand_words[0] = csprng_b();
+  csprng_b.generate(std::span(rand_words).subspan(1));
+
+  EXPECT_EQ(std::memcmp(rand_words.data(), rand_bytes.data(), rand_words.size() * sizeof(uint64_t)), 0);
+}
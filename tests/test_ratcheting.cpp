@@ -4,6 +4,9 @@
 #include <array>
 #include <cstdint>
 #include <gtest/gtest.h>
+#include <limits>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 // A dummy CSPRNG based on specified XOF choice, without ratcheting. Only squeezing after finalizing the sponge.
@@ -33,10 +36,12 @@ public:
 
 namespace {
 
-template<randomshake::xof_kind_t xof_kind>
+template<randomshake::xof_kind_t xof_kind, size_t ratchet_period_block_count = randomshake::default_ratchet_period_block_count<xof_kind>>
 void
 test_ratchet_getting_activated_post_ratchet_period_bytes_output()
 {
+  using csprng_t = randomshake::randomshake_t<uint8_t, xof_kind, ratchet_period_block_count>;
+
   // --- Paint output buffers. ---
 
   /**
@@ -60,7 +65,7 @@ test_ratchet_getting_activated_post_ratchet_period_bytes_output()
    * 2) And after these many bytes, their output should completely diverge. To detect ratcheting kick-in,
    * we paint this portion of two buffers with same byte pattern.
    */
-  constexpr auto RATCHET_PERIOD_BYTE_LEN = randomshake::xof_selector_t<xof_kind>::ratchet_period_byte_len;
+  constexpr auto RATCHET_PERIOD_BYTE_LEN = csprng_t::ratchet_period_byte_len;
 
   auto first_of_original = original_csprng_bytes_span.template first<RATCHET_PERIOD_BYTE_LEN>();
   std::fill(first_of_original.begin(), first_of_original.end(), 0x11);
@@ -79,10 +84,10 @@ test_ratchet_getting_activated_post_ratchet_period_bytes_output()
 
   // --- Painting done and tested to be working. ---
 
-  std::array<uint8_t, randomshake::randomshake_t<uint8_t, xof_kind>::seed_byte_len> seed{};
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
   seed.fill(0xde);
 
-  randomshake::randomshake_t<uint8_t, xof_kind> original_csprng(seed);
+  csprng_t original_csprng(seed);
   dummy_noratchet_csprng<xof_kind> dummy_noratchet_csprng(seed);
 
   std::ranges::generate(original_csprng_bytes_span, [&]() { return original_csprng(); });
@@ -94,6 +99,48 @@ test_ratchet_getting_activated_post_ratchet_period_bytes_output()
   EXPECT_FALSE(std::ranges::equal(last_of_original, last_of_dummy));
 }
 
+/**
+ * Reproduces the output stream of a RandomSHAKE CSPRNG, with given ratchet period, by driving the XOF instance by hand,
+ * ratcheting after every `ratchet_period_block_count` -many rate blocks, and compares it against the one squeezed in bulk.
+ */
+template<randomshake::xof_kind_t xof_kind, size_t ratchet_period_block_count>
+void
+test_ratchet_period_policy()
+{
+  using csprng_t = randomshake::randomshake_t<uint8_t, xof_kind, ratchet_period_block_count>;
+  constexpr size_t rate_byte_len = randomshake::xof_selector_t<xof_kind>::rate / std::numeric_limits<uint8_t>::digits;
+
+  static_assert(csprng_t::ratchet_period_byte_len == ratchet_period_block_count * rate_byte_len);
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  typename randomshake::xof_selector_t<xof_kind>::type xof{};
+  xof.reset();
+  xof.absorb(seed);
+  xof.finalize();
+
+  std::vector<uint8_t> expected(GENERATED_RANDOM_BYTE_LEN / 8, 0x00);
+  auto expected_span = std::span(expected);
+  for (size_t offset = 0; offset < expected.size(); offset += csprng_t::ratchet_period_byte_len) {
+    if (offset > 0) {
+      xof.ratchet(randomshake::xof_selector_t<xof_kind>::ratchet_byte_len);
+    }
+    xof.squeeze(expected_span.subspan(offset, std::min(csprng_t::ratchet_period_byte_len, expected.size() - offset)));
+  }
+
+  csprng_t csprng(seed);
+  std::vector<uint8_t> computed(expected.size(), 0x00);
+  auto computed_span = std::span(computed);
+
+  // Squeeze in odd-sized pieces, so that ratchet period boundaries are crossed at arbitrary positions.
+  for (size_t offset = 0; offset < computed.size(); offset += 1'001) {
+    csprng.generate(computed_span.subspan(offset, std::min<size_t>(1'001, computed.size() - offset)));
+  }
+
+  EXPECT_EQ(computed, expected);
+}
+
 }
 
 TEST(RandomSHAKE, Deterministic_CSPRNG_Detect_Ratchet_Working_For_SHAKE256_XOF)
@@ -105,3 +152,33 @@ TEST(RandomSHAKE, Deterministic_CSPRNG_Detect_Ratchet_Working_For_TurboSHAKE256_
 {
   test_ratchet_getting_activated_post_ratchet_period_bytes_output<randomshake::xof_kind_t::TURBOSHAKE256>();
 }
+
+TEST(RandomSHAKE, Deterministic_CSPRNG_Detect_Ratchet_Working_For_SHAKE128_XOF)
+{
+  test_ratchet_getting_activated_post_ratchet_period_bytes_output<randomshake::xof_kind_t::SHAKE128>();
+}
+
+TEST(RandomSHAKE, Deterministic_CSPRNG_Detect_Ratchet_Working_For_TurboSHAKE128_XOF)
+{
+  test_ratchet_getting_activated_post_ratchet_period_bytes_output<randomshake::xof_kind_t::TURBOSHAKE128>();
+}
+
+TEST(RandomSHAKE, Deterministic_CSPRNG_Detect_Ratchet_Working_With_Custom_Ratchet_Period)
+{
+  test_ratchet_getting_activated_post_ratchet_period_bytes_output<randomshake::xof_kind_t::SHAKE256, 1>();
+  test_ratchet_getting_activated_post_ratchet_period_bytes_output<randomshake::xof_kind_t::TURBOSHAKE256, 32>();
+}
+
+TEST(RandomSHAKE, Deterministic_CSPRNG_Ratchets_Exactly_After_Chosen_Ratchet_Period)
+{
+  test_ratchet_period_policy<randomshake::xof_kind_t::SHAKE256, 1>();
+  test_ratchet_period_policy<randomshake::xof_kind_t::SHAKE256, 8>();
+  test_ratchet_period_policy<randomshake::xof_kind_t::TURBOSHAKE256, 1>();
+  test_ratchet_period_policy<randomshake::xof_kind_t::TURBOSHAKE256, 8>();
+  test_ratchet_period_policy<randomshake::xof_kind_t::TURBOSHAKE256, 32>();
+  test_ratchet_period_policy<randomshake::xof_kind_t::SHAKE128, 8>();
+  test_ratchet_period_policy<randomshake::xof_kind_t::TURBOSHAKE128, 8>();
+
+  // Default ratchet period stays at 8 rate blocks, keeping the output stream of existing users intact.
+  static_assert(std::is_same_v<randomshake::randomshake_t<>, randomshake::randomshake_t<uint8_t, randomshake::xof_kind_t::TURBOSHAKE256, 8>>);
+}
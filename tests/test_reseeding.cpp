@@ -0,0 +1,185 @@
+#include "randomshake/fork_detection.hpp"
+#include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_reseeding.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+#if RANDOMSHAKE_HAS_FORK_DETECTION
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Deterministic "entropy source", handing out 0, 1, 2, ... for testing when and how fresh entropy gets mixed in.
+struct counting_entropy_source_t
+{
+  uint8_t next_byte = 0;
+
+  void fill(std::span<uint8_t> output)
+  {
+    for (auto& byte : output) {
+      byte = next_byte++;
+    }
+  }
+};
+
+template<randomshake::xof_kind_t xof_kind>
+void
+test_reseed_mixes_key_and_fresh_entropy()
+{
+  using csprng_t = randomshake::randomshake_t<uint8_t, xof_kind>;
+  constexpr size_t ratchet_period_byte_len = randomshake::xof_selector_t<xof_kind>::ratchet_period_byte_len;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::array<uint8_t, 48> fresh_entropy{};
+  fresh_entropy.fill(0xad);
+
+  csprng_t csprng(seed);
+
+  std::array<uint8_t, 37> consumed{};
+  csprng.generate(consumed);
+  csprng.reseed(fresh_entropy);
+
+  std::vector<uint8_t> computed(3 * ratchet_period_byte_len, 0x00);
+  csprng.generate(computed);
+
+  // Reproduce it by hand. Key is squeezed right after the first buffer-full of bytes, unread bytes being discarded.
+  typename randomshake::xof_selector_t<xof_kind>::type xof{};
+  xof.reset();
+  xof.absorb(seed);
+  xof.finalize();
+
+  std::array<uint8_t, ratchet_period_byte_len> first_period{};
+  std::array<uint8_t, csprng_t::seed_byte_len> key{};
+  xof.squeeze(first_period);
+  xof.squeeze(key);
+
+  xof.reset();
+  xof.absorb(randomshake::RESEED_DOMAIN);
+  xof.absorb(key);
+  xof.absorb(fresh_entropy);
+  xof.finalize();
+
+  std::vector<uint8_t> expected(computed.size(), 0x00);
+  auto expected_span = std::span(expected);
+  for (size_t offset = 0; offset < expected.size(); offset += ratchet_period_byte_len) {
+    if (offset > 0) {
+      xof.ratchet(randomshake::xof_selector_t<xof_kind>::ratchet_byte_len);
+    }
+    xof.squeeze(expected_span.subspan(offset, ratchet_period_byte_len));
+  }
+
+  EXPECT_EQ(computed, expected);
+}
+
+}
+
+TEST(RandomSHAKEReseeding, Reseed_Mixes_Key_And_Fresh_Entropy)
+{
+  test_reseed_mixes_key_and_fresh_entropy<randomshake::xof_kind_t::SHAKE256>();
+  test_reseed_mixes_key_and_fresh_entropy<randomshake::xof_kind_t::TURBOSHAKE256>();
+}
+
+TEST(RandomSHAKEReseeding, Reseeding_CSPRNG_Reseeds_Exactly_At_Interval)
+{
+  using reseeding_csprng_t = randomshake::randomshake_reseeding_t<uint8_t, randomshake::xof_kind_t::TURBOSHAKE256, counting_entropy_source_t>;
+  constexpr uint64_t reseed_interval_byte_len = 1'000;
+
+  std::array<uint8_t, reseeding_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  reseeding_csprng_t reseeding_csprng(seed, { .reseed_interval_byte_len = reseed_interval_byte_len, .reseed_on_fork = true });
+
+  // Squeeze in odd-sized pieces, so that reseeds fall due midway.
+  std::vector<uint8_t> computed(5 * reseed_interval_byte_len + 17, 0x00);
+  auto computed_span = std::span(computed);
+  for (size_t offset = 0; offset < computed.size(); offset += 333) {
+    reseeding_csprng.generate(computed_span.subspan(offset, std::min<size_t>(333, computed.size() - offset)));
+  }
+
+  EXPECT_EQ(reseeding_csprng.reseed_count(), 5U);
+
+  // Reproduce it, reseeding a plain CSPRNG by hand, after every `reseed_interval_byte_len` -bytes.
+  randomshake::randomshake_t csprng(seed);
+  counting_entropy_source_t source{};
+
+  std::vector<uint8_t> expected(computed.size(), 0x00);
+  auto expected_span = std::span(expected);
+  for (size_t offset = 0; offset < expected.size(); offset += reseed_interval_byte_len) {
+    if (offset > 0) {
+      csprng.reseed(source);
+    }
+    csprng.generate(expected_span.subspan(offset, std::min<size_t>(reseed_interval_byte_len, expected.size() - offset)));
+  }
+
+  EXPECT_EQ(computed, expected);
+}
+
+TEST(RandomSHAKEReseeding, Reseeding_Changes_Output_Stream)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng_a(seed);
+  randomshake::randomshake_t csprng_b(seed);
+  csprng_b.reseed();
+
+  std::array<uint8_t, 64> rand_bytes_a{};
+  std::array<uint8_t, 64> rand_bytes_b{};
+  csprng_a.generate(rand_bytes_a);
+  csprng_b.generate(rand_bytes_b);
+
+  EXPECT_NE(rand_bytes_a, rand_bytes_b);
+}
+
+#if RANDOMSHAKE_HAS_FORK_DETECTION
+TEST(RandomSHAKEReseeding, Forked_Child_Process_Reseeds)
+{
+  constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 64;
+
+  std::array<uint8_t, randomshake::randomshake_reseeding_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_reseeding_t reseeding_csprng(seed);
+
+  std::array<int, 2> pipe_fds{};
+  ASSERT_EQ(pipe(pipe_fds.data()), 0);
+
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+
+  if (pid == 0) {
+    std::array<uint8_t, RANDOM_OUTPUT_BYTE_LEN> child_bytes{};
+    reseeding_csprng.generate(child_bytes);
+
+    const bool reseeded = reseeding_csprng.reseed_count() == 1;
+    const auto written = write(pipe_fds[1], child_bytes.data(), child_bytes.size());
+    _exit((reseeded && (written == static_cast<ssize_t>(child_bytes.size()))) ? 0 : 1);
+  }
+
+  std::array<uint8_t, RANDOM_OUTPUT_BYTE_LEN> parent_bytes{};
+  reseeding_csprng.generate(parent_bytes);
+
+  std::array<uint8_t, RANDOM_OUTPUT_BYTE_LEN> child_bytes{};
+  const auto read_byte_len = read(pipe_fds[0], child_bytes.data(), child_bytes.size());
+
+  int child_status = 0;
+  waitpid(pid, &child_status, 0);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+
+  ASSERT_TRUE(WIFEXITED(child_status));
+  ASSERT_EQ(WEXITSTATUS(child_status), 0);
+  ASSERT_EQ(read_byte_len, static_cast<ssize_t>(child_bytes.size()));
+
+  EXPECT_EQ(reseeding_csprng.reseed_count(), 0U);
+  EXPECT_NE(parent_bytes, child_bytes);
+}
+#endif
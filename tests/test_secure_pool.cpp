@@ -0,0 +1,155 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/secure_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <set>
+#include <span>
+#include <thread>
+#include <vector>
+
+#if RANDOMSHAKE_HAS_POSIX_MMAN
+
+TEST(RandomSHAKESecurePool, Slots_Are_Distinct_Aligned_And_Reused)
+{
+  constexpr size_t capacity = 8;
+  randomshake::secure_pool_t<randomshake::randomshake_t<uint64_t>> pool(capacity);
+
+  EXPECT_EQ(pool.capacity(), capacity);
+  EXPECT_TRUE(pool.is_locked() || (pool.error() != 0));
+  EXPECT_EQ(pool.slot_byte_len % 64, 0U);
+
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::vector<randomshake::randomshake_t<uint64_t>*> csprngs;
+  for (size_t i = 0; i < capacity; i++) {
+    auto* csprng = pool.create(seed);
+    ASSERT_NE(csprng, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(csprng) % 64, 0U); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    csprngs.push_back(csprng);
+  }
+
+  EXPECT_EQ(std::set(csprngs.begin(), csprngs.end()).size(), capacity);
+  EXPECT_EQ(pool.create(seed), nullptr);
+
+  // Released slot is handed out again.
+  auto* released = csprngs.back();
+  csprngs.pop_back();
+  pool.destroy(released);
+
+  auto* reused = pool.create(seed);
+  EXPECT_EQ(reused, released);
+  csprngs.push_back(reused);
+
+  for (auto* csprng : csprngs) {
+    pool.destroy(csprng);
+  }
+}
+
+TEST(RandomSHAKESecurePool, Pooled_Instance_Produces_Same_Output_As_Any_Other)
+{
+  randomshake::secure_pool_t<randomshake::randomshake_t<uint64_t>> pool(4);
+
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> reference(seed);
+  auto pooled = pool.make_unique(seed);
+  ASSERT_NE(pooled, nullptr);
+
+  for (size_t i = 0; i < 1'000; i++) {
+    EXPECT_EQ((*pooled)(), reference());
+  }
+}
+
+TEST(RandomSHAKESecurePool, Released_Slot_Is_Zeroized)
+{
+  randomshake::secure_pool_t<randomshake::randomshake_t<uint64_t>> pool(1);
+
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  auto* csprng = pool.create(seed);
+  ASSERT_NE(csprng, nullptr);
+
+  const auto slot = std::span(reinterpret_cast<const uint8_t*>(csprng), pool.slot_byte_len); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  EXPECT_FALSE(std::ranges::all_of(slot, [](const uint8_t byte) { return byte == 0; }));
+
+  pool.destroy(csprng);
+  EXPECT_TRUE(std::ranges::all_of(slot, [](const uint8_t byte) { return byte == 0; }));
+}
+
+TEST(RandomSHAKESecurePool, Arena_Spanning_Huge_Page_Is_Usable_With_Or_Without_Them)
+{
+  using csprng_t = randomshake::randomshake_t<uint64_t>;
+  using pool_t = randomshake::secure_pool_t<csprng_t>;
+
+  // Just enough slots to fill a 2MB huge page, which is backed by normal pages, if no huge page is reserved.
+  constexpr size_t capacity = (2UL * 1'024UL * 1'024UL + pool_t::slot_byte_len - 1) / pool_t::slot_byte_len;
+  pool_t pool(capacity);
+
+  EXPECT_EQ(pool.capacity(), capacity);
+  EXPECT_TRUE(pool.is_locked() || (pool.error() != 0));
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  csprng_t reference(seed);
+  auto first = pool.make_unique(seed);
+  ASSERT_NE(first, nullptr);
+
+  std::vector<csprng_t*> csprngs;
+  for (size_t i = 1; i < capacity; i++) {
+    csprngs.push_back(pool.create(seed));
+    ASSERT_NE(csprngs.back(), nullptr);
+  }
+  EXPECT_EQ(pool.create(seed), nullptr);
+
+  // Last slot sits at the very end of the arena.
+  EXPECT_EQ((*csprngs.back())(), reference());
+
+  for (auto* csprng : csprngs) {
+    pool.destroy(csprng);
+  }
+}
+
+TEST(RandomSHAKESecurePool, Concurrent_Create_And_Destroy_Never_Shares_Slots)
+{
+  constexpr size_t num_threads = 4;
+  constexpr size_t num_rounds = 10'000;
+
+  // Fewer slots than threads, so that threads keep competing for them.
+  randomshake::secure_pool_t<std::atomic<uint64_t>> pool(num_threads - 1);
+  std::atomic<size_t> num_shared_slots{ 0 };
+
+  {
+    std::vector<std::jthread> threads;
+    for (size_t thread_idx = 0; thread_idx < num_threads; thread_idx++) {
+      threads.emplace_back([&, thread_idx]() {
+        for (size_t round = 0; round < num_rounds; round++) {
+          auto* owner = pool.create(thread_idx);
+          if (owner == nullptr) {
+            std::this_thread::yield();
+            continue;
+          }
+
+          // Slot must hold the owner's id all along, as it's zeroized on release and nobody else may write to it meanwhile.
+          std::this_thread::yield();
+          if (owner->load() != thread_idx) {
+            num_shared_slots.fetch_add(1);
+          }
+
+          pool.destroy(owner);
+        }
+      });
+    }
+  }
+
+  EXPECT_EQ(num_shared_slots.load(), 0U);
+}
+
+#endif
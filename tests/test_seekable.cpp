@@ -0,0 +1,166 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/randomshake_seekable.hpp"
+#include "test_consts.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t KAT_BLOCK_INDEX = 1'000'000;
+
+/**
+ * First 32 -bytes of block 0 and block `KAT_BLOCK_INDEX` of the seekable CSPRNG's output stream, for a seed filled with 0xde.
+ * These are the first 32 -bytes of XOF(DOMAIN || SEED || LE64(block_index)), computed independently of this library.
+ */
+constexpr std::array<uint8_t, 32> SHAKE256_KAT_BLOCK_0 = { 0x57, 0x83, 0xc7, 0x43, 0x97, 0x1e, 0x62, 0x74, 0x4f, 0xa6, 0xaf,
+                                                           0xa8, 0x07, 0x34, 0xb1, 0x57, 0xea, 0x2d, 0x1d, 0x1d, 0x74, 0x25,
+                                                           0x71, 0x4d, 0x16, 0x00, 0x96, 0xaf, 0x80, 0x9b, 0x70, 0x2e };
+constexpr std::array<uint8_t, 32> SHAKE256_KAT_BLOCK_N = { 0x35, 0xfe, 0xbf, 0xde, 0x35, 0xd6, 0xca, 0x70, 0x15, 0xc7, 0x34,
+                                                           0x20, 0x5f, 0x50, 0x63, 0x3d, 0x90, 0x77, 0x9b, 0x5d, 0xc4, 0x15,
+                                                           0xd2, 0x79, 0x98, 0xe5, 0xf0, 0xac, 0x8b, 0xf6, 0xa4, 0x0a };
+constexpr std::array<uint8_t, 32> TURBOSHAKE256_KAT_BLOCK_0 = { 0x06, 0x41, 0x4e, 0x7e, 0xd8, 0x3e, 0x05, 0x9c, 0x7b, 0xc8, 0xf8,
+                                                                0x07, 0xfc, 0x4e, 0x4f, 0xbd, 0xe6, 0x3d, 0xeb, 0x22, 0x6d, 0x15,
+                                                                0x8c, 0x52, 0x53, 0x93, 0xb5, 0xf6, 0xe5, 0x8a, 0x72, 0x74 };
+constexpr std::array<uint8_t, 32> TURBOSHAKE256_KAT_BLOCK_N = { 0x05, 0xb1, 0xa2, 0xe3, 0xfb, 0xa7, 0x59, 0xf2, 0xa5, 0x00, 0x8b,
+                                                                0x9b, 0xdf, 0xab, 0xb8, 0x44, 0xd8, 0x7b, 0xe8, 0x7e, 0x1a, 0x9e,
+                                                                0x6f, 0xb8, 0x24, 0x83, 0x44, 0x30, 0x91, 0x97, 0xe8, 0x4f };
+
+template<randomshake::xof_kind_t xof_kind>
+void
+test_seekable_csprng_known_answers(std::span<const uint8_t, 32> expected_block_0, std::span<const uint8_t, 32> expected_block_n)
+{
+  using csprng_t = randomshake::randomshake_seekable_t<uint8_t, xof_kind>;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  csprng_t csprng(seed);
+  std::array<uint8_t, 32> computed{};
+
+  csprng.generate(computed);
+  EXPECT_TRUE(std::ranges::equal(computed, expected_block_0));
+
+  csprng.seek(KAT_BLOCK_INDEX);
+  csprng.generate(computed);
+  EXPECT_TRUE(std::ranges::equal(computed, expected_block_n));
+
+  csprng.generate_at(KAT_BLOCK_INDEX * csprng_t::block_byte_len, computed);
+  EXPECT_TRUE(std::ranges::equal(computed, expected_block_n));
+}
+
+template<randomshake::xof_kind_t xof_kind>
+void
+test_seekable_csprng_random_access_matches_sequential_stream()
+{
+  using csprng_t = randomshake::randomshake_seekable_t<uint8_t, xof_kind>;
+  constexpr size_t block_byte_len = csprng_t::block_byte_len;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  // Sequential output stream, squeezed in odd-sized pieces, so that block boundaries are crossed at arbitrary positions.
+  std::vector<uint8_t> sequential(GENERATED_RANDOM_BYTE_LEN / 64, 0x00);
+  {
+    csprng_t csprng(seed);
+    auto sequential_span = std::span(sequential);
+
+    size_t offset = 0;
+    size_t piece_len = 1;
+    while (offset < sequential.size()) {
+      const size_t len = std::min(piece_len, sequential.size() - offset);
+      csprng.generate(sequential_span.subspan(offset, len));
+
+      offset += len;
+      piece_len = (piece_len * 7 + 3) % (3 * block_byte_len);
+    }
+
+    EXPECT_EQ(csprng.tell(), sequential.size());
+  }
+
+  csprng_t csprng(seed);
+
+  // `generate_at` reproduces any window of the sequential stream, without moving current position.
+  for (const size_t window_offset : { size_t{ 0 }, size_t{ 1 }, block_byte_len - 1, block_byte_len, 3 * block_byte_len + 17 }) {
+    for (const size_t window_len : { size_t{ 0 }, size_t{ 1 }, block_byte_len - 1, block_byte_len, 2 * block_byte_len + 5 }) {
+      std::vector<uint8_t> window(window_len, 0x00);
+      csprng.generate_at(window_offset, window);
+
+      EXPECT_TRUE(std::equal(window.begin(), window.end(), sequential.begin() + static_cast<ptrdiff_t>(window_offset)));
+      EXPECT_EQ(csprng.tell(), 0U);
+    }
+  }
+
+  // `seek`-ing to a block and then squeezing, reproduces the sequential stream from beginning of that block.
+  for (const uint64_t blk_idx : { uint64_t{ 5 }, uint64_t{ 0 }, uint64_t{ 2 } }) {
+    csprng.seek(blk_idx);
+    EXPECT_EQ(csprng.tell(), blk_idx * block_byte_len);
+
+    std::vector<uint8_t> from_block(3 * block_byte_len + 1, 0x00);
+    csprng.generate(from_block);
+
+    EXPECT_TRUE(std::equal(from_block.begin(), from_block.end(), sequential.begin() + static_cast<ptrdiff_t>(blk_idx * block_byte_len)));
+  }
+}
+
+}
+
+TEST(RandomSHAKESeekable, Known_Answer_Tests)
+{
+  test_seekable_csprng_known_answers<randomshake::xof_kind_t::SHAKE256>(SHAKE256_KAT_BLOCK_0, SHAKE256_KAT_BLOCK_N);
+  test_seekable_csprng_known_answers<randomshake::xof_kind_t::TURBOSHAKE256>(TURBOSHAKE256_KAT_BLOCK_0, TURBOSHAKE256_KAT_BLOCK_N);
+}
+
+TEST(RandomSHAKESeekable, Random_Access_Matches_Sequential_Stream)
+{
+  test_seekable_csprng_random_access_matches_sequential_stream<randomshake::xof_kind_t::SHAKE256>();
+  test_seekable_csprng_random_access_matches_sequential_stream<randomshake::xof_kind_t::TURBOSHAKE256>();
+}
+
+TEST(RandomSHAKESeekable, Scalar_And_Batched_Squeezing_Agree)
+{
+  using csprng_t = randomshake::randomshake_seekable_t<uint64_t>;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  csprng_t csprng_a(seed);
+  csprng_t csprng_b(seed);
+
+  // Leave a partial word in the buffer, right before a block boundary, so that the next scalar squeeze straddles it.
+  std::array<uint8_t, csprng_t::block_byte_len - 3> prefix_a{};
+  std::array<uint8_t, csprng_t::block_byte_len - 3> prefix_b{};
+  csprng_a.generate(prefix_a);
+  csprng_b.generate(prefix_b);
+
+  std::vector<uint64_t> scalar(1'024, 0);
+  std::vector<uint64_t> batched(scalar.size(), 0);
+
+  std::ranges::generate(scalar, [&]() { return csprng_a(); });
+  csprng_b.generate(std::span<uint64_t>(batched));
+
+  EXPECT_EQ(scalar, batched);
+  EXPECT_EQ(csprng_a.tell(), csprng_b.tell());
+}
+
+TEST(RandomSHAKESeekable, Different_Seeds_Produce_Different_Streams)
+{
+  using csprng_t = randomshake::randomshake_seekable_t<>;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  csprng_t csprng_a(seed);
+  seed[0] ^= 0x01;
+  csprng_t csprng_b(seed);
+
+  std::array<uint8_t, csprng_t::block_byte_len> stream_a{};
+  std::array<uint8_t, csprng_t::block_byte_len> stream_b{};
+  csprng_a.generate_at(7 * csprng_t::block_byte_len, stream_a);
+  csprng_b.generate_at(7 * csprng_t::block_byte_len, stream_b);
+
+  EXPECT_NE(stream_a, stream_b);
+}
@@ -0,0 +1,103 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/shuffle.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <map>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace {
+
+std::vector<uint32_t>
+make_identity(const size_t n)
+{
+  std::vector<uint32_t> values(n, 0);
+  std::iota(values.begin(), values.end(), 0);
+
+  return values;
+}
+
+}
+
+TEST(RandomSHAKEShuffle, Shuffle_Produces_A_Permutation)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  for (const size_t n : { 0UL, 1UL, 2UL, 3UL, 1'000UL, 100'003UL }) {
+    auto values = make_identity(n);
+    randomshake::shuffle(csprng, values);
+
+    if (n > 8) {
+      EXPECT_NE(values, make_identity(n));
+    }
+
+    std::ranges::sort(values);
+    EXPECT_EQ(values, make_identity(n));
+  }
+}
+
+TEST(RandomSHAKEShuffle, Shuffle_Draws_Two_Indices_From_One_Word)
+{
+  // First word gets rejected, second one maps to offsets (1, 1), for bounds (3, 2).
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = { 1ULL << 63, (1ULL << 63) + 1 } };
+
+  std::array<uint32_t, 3> values = { 0, 1, 2 };
+  randomshake::shuffle(generator, values);
+
+  EXPECT_EQ(values, (std::array<uint32_t, 3>{ 1, 2, 0 }));
+}
+
+TEST(RandomSHAKEShuffle, Shuffle_Is_Uniform_Over_Permutations)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  constexpr size_t num_rounds = 24'000;
+  std::map<std::array<uint8_t, 4>, size_t> permutation_counts{};
+
+  for (size_t round = 0; round < num_rounds; round++) {
+    std::array<uint8_t, 4> values = { 0, 1, 2, 3 };
+    randomshake::shuffle(csprng, values);
+
+    permutation_counts[values]++;
+  }
+
+  // Each of 24 permutations is expected 1000 times, with standard deviation ~31.
+  EXPECT_EQ(permutation_counts.size(), 24U);
+  EXPECT_TRUE(std::ranges::all_of(permutation_counts, [](const auto& entry) { return (entry.second > 850) && (entry.second < 1'150); }));
+}
+
+TEST(RandomSHAKEShuffle, Sample_Is_Prefix_Of_Shuffle)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  const auto population = make_identity(10'000);
+
+  // Covers both sparse and dense sampling, odd and even sample counts and sampling more than the population.
+  for (const size_t k : { 0UL, 1UL, 7UL, 100UL, 2'499UL, 2'500UL, 9'999UL, 10'000UL, 20'000UL }) {
+    randomshake::randomshake_t csprng_a(seed);
+    const auto sampled = randomshake::sample(csprng_a, population, k);
+
+    randomshake::randomshake_t csprng_b(seed);
+    auto shuffled = population;
+    randomshake::shuffle(csprng_b, shuffled);
+
+    const size_t num_samples = std::min(k, population.size());
+    ASSERT_EQ(sampled.size(), num_samples);
+    EXPECT_TRUE(std::ranges::equal(sampled, std::span(shuffled).first(num_samples)));
+
+    auto distinct = sampled;
+    std::ranges::sort(distinct);
+    EXPECT_EQ(std::ranges::adjacent_find(distinct), distinct.end());
+  }
+}
@@ -0,0 +1,181 @@
+#include "randomshake/randomshake.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+template<randomshake::xof_kind_t xof_kind, size_t ratchet_period_block_count = randomshake::default_ratchet_period_block_count<xof_kind>>
+void
+test_imported_state_continues_output_stream()
+{
+  using csprng_t = randomshake::randomshake_t<uint8_t, xof_kind, ratchet_period_block_count>;
+  constexpr size_t ratchet_period_byte_len = csprng_t::ratchet_period_byte_len;
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::array<uint8_t, csprng_t::seed_byte_len> other_seed{};
+  other_seed.fill(0xad);
+
+  // Export at the beginning, in the middle and exactly at the end of the internal buffer, and across ratchet periods.
+  for (const size_t num_consumed_bytes : { size_t{ 0 }, size_t{ 1 }, ratchet_period_byte_len - 1, ratchet_period_byte_len, 3 * ratchet_period_byte_len + 5 }) {
+    csprng_t csprng(seed);
+
+    std::vector<uint8_t> consumed(num_consumed_bytes, 0x00);
+    csprng.generate(consumed);
+
+    std::vector<uint8_t> exported(csprng_t::exported_state_max_byte_len, 0x00);
+    const size_t exported_byte_len = csprng.export_state(std::span<uint8_t, csprng_t::exported_state_max_byte_len>(exported));
+    EXPECT_LE(exported_byte_len, exported.size());
+
+    csprng_t restored(other_seed);
+    EXPECT_TRUE(restored.import_state(std::span(exported).first(exported_byte_len)));
+
+    std::vector<uint8_t> expected(2 * ratchet_period_byte_len + 3, 0x00);
+    std::vector<uint8_t> computed(expected.size(), 0x00);
+    csprng.generate(expected);
+    restored.generate(computed);
+
+    EXPECT_EQ(computed, expected);
+  }
+}
+
+}
+
+TEST(RandomSHAKEStateExport, Imported_State_Continues_Output_Stream)
+{
+  test_imported_state_continues_output_stream<randomshake::xof_kind_t::SHAKE256>();
+  test_imported_state_continues_output_stream<randomshake::xof_kind_t::TURBOSHAKE256>();
+}
+
+TEST(RandomSHAKEStateExport, Imported_State_Continues_Output_Stream_With_Large_Ratchet_Period)
+{
+  // Unread buffered bytes may not fit in 16 -bits, with such long ratchet periods.
+  test_imported_state_continues_output_stream<randomshake::xof_kind_t::TURBOSHAKE256, 500>();
+  test_imported_state_continues_output_stream<randomshake::xof_kind_t::SHAKE128, 1'000>();
+}
+
+TEST(RandomSHAKEStateExport, Exported_State_Omits_Consumed_Bytes)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::array<uint8_t, randomshake::randomshake_t<>::exported_state_max_byte_len> exported{};
+  const size_t fresh_byte_len = csprng.export_state(exported);
+  EXPECT_EQ(fresh_byte_len, exported.size());
+
+  std::array<uint8_t, 100> consumed{};
+  csprng.generate(consumed);
+
+  EXPECT_EQ(csprng.export_state(exported), fresh_byte_len - consumed.size());
+}
+
+TEST(RandomSHAKEStateExport, Malformed_State_Is_Rejected)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+  randomshake::randomshake_t<uint8_t, randomshake::xof_kind_t::SHAKE256> shake256_csprng(seed);
+
+  std::array<uint8_t, 37> consumed{};
+  csprng.generate(consumed);
+
+  std::array<uint8_t, randomshake::randomshake_t<>::exported_state_max_byte_len> exported{};
+  const size_t exported_byte_len = csprng.export_state(exported);
+  const auto exported_span = std::span(exported).first(exported_byte_len);
+
+  std::array<uint8_t, decltype(shake256_csprng)::exported_state_max_byte_len> shake256_exported{};
+  const size_t shake256_exported_byte_len = shake256_csprng.export_state(shake256_exported);
+
+  // Expected output stream of a CSPRNG, which rejected all malformed states, is that of a freshly seeded one.
+  randomshake::randomshake_t reference(seed);
+  randomshake::randomshake_t restored(seed);
+
+  // Truncated, or with trailing bytes.
+  EXPECT_FALSE(restored.import_state(exported_span.first(exported_byte_len - 1)));
+  EXPECT_FALSE(restored.import_state(exported_span.first(randomshake::EXPORTED_STATE_HEADER_BYTE_LEN - 1)));
+  EXPECT_FALSE(restored.import_state(std::span(exported).first(exported_byte_len + 1)));
+
+  // Exported from a CSPRNG of different XOF kind.
+  EXPECT_FALSE(restored.import_state(std::span(shake256_exported).first(shake256_exported_byte_len)));
+
+  // Exported from a CSPRNG of different ratchet period.
+  randomshake::randomshake_t<uint8_t, randomshake::xof_kind_t::TURBOSHAKE256, 1> short_period_csprng(seed);
+  std::array<uint8_t, decltype(short_period_csprng)::exported_state_max_byte_len> short_period_exported{};
+  const size_t short_period_exported_byte_len = short_period_csprng.export_state(short_period_exported);
+
+  EXPECT_FALSE(restored.import_state(std::span(short_period_exported).first(short_period_exported_byte_len)));
+
+  // Bad magic, version, XOF kind, ratchet period or squeeze offset.
+  for (const size_t tampered_idx : { size_t{ 0 }, size_t{ 4 }, size_t{ 5 }, size_t{ 6 }, size_t{ 8 } }) {
+    auto tampered = exported;
+    tampered[tampered_idx] ^= 0x01;
+
+    EXPECT_FALSE(restored.import_state(std::span(tampered).first(exported_byte_len)));
+  }
+
+  std::array<uint8_t, 256> expected{};
+  std::array<uint8_t, 256> computed{};
+  reference.generate(expected);
+  restored.generate(computed);
+
+  EXPECT_EQ(computed, expected);
+}
+
+TEST(RandomSHAKEStateExport, Corrupted_State_Is_Rejected)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::array<uint8_t, 37> consumed{};
+  csprng.generate(consumed);
+
+  std::array<uint8_t, randomshake::randomshake_t<>::exported_state_max_byte_len> exported{};
+  const size_t exported_byte_len = csprng.export_state(exported);
+
+  randomshake::randomshake_t restored(seed);
+
+  // Flipped bit in the lanes of the sponge, in unread buffered bytes or in the checksum itself.
+  constexpr size_t lanes_offset = randomshake::EXPORTED_STATE_HEADER_BYTE_LEN;
+  constexpr size_t unread_offset = lanes_offset + randomshake::EXPORTED_KECCAK_STATE_BYTE_LEN;
+
+  for (const size_t tampered_idx : { lanes_offset, lanes_offset + 100, unread_offset - 1, unread_offset, exported_byte_len - 1 }) {
+    auto tampered = exported;
+    tampered[tampered_idx] ^= 0x80;
+
+    EXPECT_FALSE(restored.import_state(std::span(tampered).first(exported_byte_len)));
+  }
+
+  // Squeeze offset beyond the rate, even with a matching checksum.
+  auto tampered = exported;
+  const uint16_t squeeze_offset = randomshake::xof_selector_t<randomshake::xof_kind_t::TURBOSHAKE256>::rate / 8 + 1;
+  std::memcpy(&tampered[randomshake::EXPORTED_STATE_MAGIC.size() + 2 + sizeof(uint16_t)], &squeeze_offset, sizeof(squeeze_offset));
+
+  const auto checksummed = std::span(tampered).first(exported_byte_len - randomshake::EXPORTED_STATE_CHECKSUM_BYTE_LEN);
+  turboshake256::turboshake256_t hasher{};
+  hasher.absorb(randomshake::EXPORTED_STATE_CHECKSUM_DOMAIN);
+  hasher.absorb(checksummed);
+  hasher.finalize();
+  hasher.squeeze(std::span(tampered).subspan(checksummed.size(), randomshake::EXPORTED_STATE_CHECKSUM_BYTE_LEN));
+
+  EXPECT_FALSE(restored.import_state(std::span(tampered).first(exported_byte_len)));
+
+  // Original one is still accepted.
+  EXPECT_TRUE(restored.import_state(std::span(exported).first(exported_byte_len)));
+
+  std::array<uint8_t, 256> expected{};
+  std::array<uint8_t, 256> computed{};
+  csprng.generate(expected);
+  restored.generate(computed);
+
+  EXPECT_EQ(computed, expected);
+}
@@ -0,0 +1,76 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/stream_to_fd.hpp"
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+#if RANDOMSHAKE_HAS_POSIX_WRITE
+
+namespace {
+
+// Streams `num_bytes` random bytes into a temporary file, in blocks of `block_byte_len` -bytes, and reads them back.
+std::vector<uint8_t>
+stream_to_temporary_file(const uint64_t num_bytes, const size_t block_byte_len)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::FILE* file = std::tmpfile();
+  EXPECT_NE(file, nullptr);
+  if (file == nullptr) {
+    return {};
+  }
+
+  const auto stats = randomshake::stream_to_fd(csprng, fileno(file), num_bytes, block_byte_len);
+  EXPECT_EQ(stats.error, 0);
+  EXPECT_EQ(stats.num_bytes_written, num_bytes);
+
+  std::vector<uint8_t> streamed(static_cast<size_t>(num_bytes), 0);
+  std::rewind(file);
+  EXPECT_EQ(std::fread(streamed.data(), 1, streamed.size(), file), streamed.size());
+  std::fclose(file);
+
+  return streamed;
+}
+
+}
+
+TEST(RandomSHAKEStreamToFd, Streamed_Bytes_Are_Same_As_Generated_Bytes)
+{
+  // Covers a single partial block, many blocks with a partial last one and block length not being a multiple of page size.
+  for (const auto& [num_bytes, block_byte_len] : { std::pair<uint64_t, size_t>{ 1'000, 4'096 },
+                                                   std::pair<uint64_t, size_t>{ 1'000'003, 4'096 },
+                                                   std::pair<uint64_t, size_t>{ 100'000, 10'000 } }) {
+    const auto streamed = stream_to_temporary_file(num_bytes, block_byte_len);
+
+    std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+    seed.fill(0xde);
+
+    randomshake::randomshake_t csprng(seed);
+    std::vector<uint8_t> generated(static_cast<size_t>(num_bytes), 0);
+    csprng.generate(generated);
+
+    EXPECT_EQ(streamed, generated);
+  }
+}
+
+TEST(RandomSHAKEStreamToFd, Write_Error_Is_Reported)
+{
+  randomshake::randomshake_t csprng{};
+
+  const auto stats = randomshake::stream_to_fd(csprng, -1, 1'000'000, 4'096);
+  EXPECT_EQ(stats.error, EBADF);
+  EXPECT_EQ(stats.num_bytes_written, 0U);
+
+  const auto empty_stats = randomshake::stream_to_fd(csprng, -1, 0);
+  EXPECT_EQ(empty_stats.error, 0);
+  EXPECT_EQ(empty_stats.num_bytes_written, 0U);
+}
+
+#endif
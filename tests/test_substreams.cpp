@@ -0,0 +1,139 @@
+#include "randomshake/randomshake_substreams.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Checks first 32 bytes squeezed from children derived from label "entity/42" and from id 1'000'000, with seed filled with 0xde.
+template<randomshake::xof_kind_t xof_kind>
+void
+test_substreams_known_answer(std::span<const uint8_t, 32> expected_labelled, std::span<const uint8_t, 32> expected_numbered)
+{
+  std::array<uint8_t, randomshake::randomshake_substreams_t<xof_kind>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  const randomshake::randomshake_substreams_t<xof_kind> substreams(seed);
+
+  std::array<uint8_t, 32> computed{};
+
+  auto labelled = substreams.derive("entity/42");
+  labelled.generate(computed);
+  EXPECT_TRUE(std::ranges::equal(computed, expected_labelled));
+
+  auto numbered = substreams.substream(1'000'000);
+  numbered.generate(computed);
+  EXPECT_TRUE(std::ranges::equal(computed, expected_numbered));
+}
+
+// Deterministic "entropy source", handing out 0, 1, 2, ... for testing how substreams are seeded from entropy sources.
+struct counting_entropy_source_t
+{
+  uint8_t next_byte = 0;
+
+  void fill(std::span<uint8_t> output)
+  {
+    for (auto& byte : output) {
+      byte = next_byte++;
+    }
+  }
+};
+
+template<typename csprng_t>
+std::vector<uint8_t>
+squeeze(csprng_t&& csprng, const size_t byte_len)
+{
+  std::vector<uint8_t> output(byte_len, 0);
+  csprng.generate(output);
+
+  return output;
+}
+
+}
+
+TEST(RandomSHAKESubstreams, Known_Answer_Tests)
+{
+  // SHAKE256 answers are cross-checked with SHAKE256(DOMAIN || SEED || TAG || LABEL), computed by Python's hashlib.
+  constexpr std::array<uint8_t, 32> SHAKE256_LABELLED_KAT = { 0x2f, 0x49, 0x70, 0x59, 0x68, 0x33, 0x05, 0x3c, 0xc0, 0x66, 0x3d,
+                                                              0x7a, 0xd3, 0x4d, 0xdc, 0x88, 0x37, 0x1c, 0x78, 0xea, 0x15, 0x13,
+                                                              0x9d, 0xbd, 0x1a, 0x58, 0x53, 0xf6, 0xf7, 0x0c, 0xa7, 0xde };
+  constexpr std::array<uint8_t, 32> SHAKE256_NUMBERED_KAT = { 0x02, 0xe5, 0xf5, 0x21, 0xbe, 0x9a, 0x76, 0x8d, 0xe3, 0x5c, 0x17,
+                                                              0x27, 0x6c, 0x6a, 0x93, 0xe3, 0xef, 0x40, 0x65, 0x60, 0x89, 0x26,
+                                                              0x12, 0x66, 0x71, 0x40, 0x9b, 0x7c, 0xdc, 0xba, 0xc4, 0x67 };
+  constexpr std::array<uint8_t, 32> TURBOSHAKE256_LABELLED_KAT = { 0x78, 0xc4, 0x1a, 0x49, 0x93, 0x0f, 0x1f, 0xb4, 0xf1, 0x20, 0xe1,
+                                                                   0xe4, 0xb6, 0xf7, 0xfe, 0xd3, 0xe6, 0xcb, 0x22, 0x9d, 0x56, 0x7b,
+                                                                   0x20, 0x0c, 0xb6, 0xcd, 0x46, 0x05, 0x93, 0x7f, 0xaa, 0x56 };
+  constexpr std::array<uint8_t, 32> TURBOSHAKE256_NUMBERED_KAT = { 0x7b, 0xf6, 0xa1, 0x42, 0xc3, 0x23, 0x8c, 0xd9, 0x8c, 0x16, 0x97,
+                                                                   0x76, 0xd9, 0x8a, 0xb4, 0x74, 0x45, 0x44, 0xd8, 0x28, 0xcc, 0x15,
+                                                                   0x41, 0xd5, 0x09, 0x4a, 0x3c, 0x17, 0x0f, 0xdb, 0x2b, 0x67 };
+
+  test_substreams_known_answer<randomshake::xof_kind_t::SHAKE256>(SHAKE256_LABELLED_KAT, SHAKE256_NUMBERED_KAT);
+  test_substreams_known_answer<randomshake::xof_kind_t::TURBOSHAKE256>(TURBOSHAKE256_LABELLED_KAT, TURBOSHAKE256_NUMBERED_KAT);
+}
+
+TEST(RandomSHAKESubstreams, Children_Are_Deterministic_And_Domain_Separated)
+{
+  std::array<uint8_t, randomshake::randomshake_substreams_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::array<uint8_t, randomshake::randomshake_substreams_t<>::seed_byte_len> other_seed{};
+  other_seed.fill(0xad);
+
+  const randomshake::randomshake_substreams_t substreams(seed);
+  const randomshake::randomshake_substreams_t other_substreams(other_seed);
+
+  // Spans a few ratchet periods.
+  constexpr size_t byte_len = 3 * randomshake::randomshake_t<>::ratchet_period_byte_len + 7;
+
+  EXPECT_EQ(squeeze(substreams.derive("entity/42"), byte_len), squeeze(substreams.derive("entity/42"), byte_len));
+  EXPECT_EQ(squeeze(substreams.substream(42), byte_len), squeeze(substreams.substream(42), byte_len));
+
+  EXPECT_NE(squeeze(substreams.derive("entity/42"), byte_len), squeeze(substreams.derive("entity/43"), byte_len));
+  EXPECT_NE(squeeze(substreams.derive("entity/42"), byte_len), squeeze(substreams.derive("entity/42/"), byte_len));
+  EXPECT_NE(squeeze(substreams.substream(42), byte_len), squeeze(substreams.substream(43), byte_len));
+  EXPECT_NE(squeeze(substreams.substream(42), byte_len), squeeze(other_substreams.substream(42), byte_len));
+
+  // A label holding the same bytes as an id must not produce the same stream.
+  const uint64_t id = 42;
+  std::array<uint8_t, sizeof(id)> id_bytes{};
+  std::memcpy(id_bytes.data(), &id, sizeof(id));
+
+  EXPECT_NE(squeeze(substreams.derive(std::span<const uint8_t>(id_bytes)), byte_len), squeeze(substreams.substream(id), byte_len));
+}
+
+TEST(RandomSHAKESubstreams, Typed_Children_Produce_Same_Stream)
+{
+  std::array<uint8_t, randomshake::randomshake_substreams_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  const randomshake::randomshake_substreams_t substreams(seed);
+
+  auto byte_child = substreams.substream(7);
+  auto u64_child = substreams.substream<uint64_t>(7);
+
+  for (size_t i = 0; i < 1'000; i++) {
+    std::array<uint8_t, sizeof(uint64_t)> bytes{};
+    byte_child.generate(bytes);
+
+    uint64_t expected = 0;
+    std::memcpy(&expected, bytes.data(), bytes.size());
+
+    EXPECT_EQ(u64_child(), expected);
+  }
+}
+
+TEST(RandomSHAKESubstreams, Seeded_From_Entropy_Source_Matches_Explicit_Seed)
+{
+  std::array<uint8_t, randomshake::randomshake_substreams_t<>::seed_byte_len> seed{};
+  counting_entropy_source_t{}.fill(seed);
+
+  const randomshake::randomshake_substreams_t<> substreams_a(counting_entropy_source_t{});
+  const randomshake::randomshake_substreams_t<> substreams_b(seed);
+
+  EXPECT_EQ(squeeze(substreams_a.derive("entity/42"), 1'024), squeeze(substreams_b.derive("entity/42"), 1'024));
+  EXPECT_EQ(squeeze(substreams_a.substream(7), 1'024), squeeze(substreams_b.substream(7), 1'024));
+}
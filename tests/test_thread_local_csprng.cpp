@@ -0,0 +1,95 @@
+#include "randomshake/fork_detection.hpp"
+#include "randomshake/thread_local_csprng.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#if RANDOMSHAKE_HAS_FORK_DETECTION
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+TEST(RandomSHAKEThreadLocal, Same_Thread_Gets_Same_CSPRNG_Instance)
+{
+  auto& csprng_a = randomshake::thread_local_csprng();
+  auto& csprng_b = randomshake::thread_local_csprng();
+
+  EXPECT_EQ(&csprng_a, &csprng_b);
+
+  // Different result type, means a different instance.
+  auto& csprng_c = randomshake::thread_local_csprng<uint64_t>();
+  EXPECT_NE(static_cast<const void*>(&csprng_a), static_cast<const void*>(&csprng_c));
+}
+
+TEST(RandomSHAKEThreadLocal, Different_Threads_Produce_Ne_Output)
+{
+  constexpr size_t NUM_THREADS = 4;
+  constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 1'024;
+
+  std::vector<std::vector<uint8_t>> rand_bytes(NUM_THREADS, std::vector<uint8_t>(RANDOM_OUTPUT_BYTE_LEN, 0x00));
+  std::vector<std::thread> threads{};
+
+  for (size_t thread_idx = 0; thread_idx < NUM_THREADS; thread_idx++) {
+    threads.emplace_back([&rand_bytes, thread_idx]() { randomshake::thread_local_csprng().generate(rand_bytes[thread_idx]); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<uint8_t> rand_bytes_main(RANDOM_OUTPUT_BYTE_LEN, 0x00);
+  randomshake::thread_local_csprng().generate(rand_bytes_main);
+
+  for (size_t i = 0; i < NUM_THREADS; i++) {
+    EXPECT_NE(rand_bytes[i], rand_bytes_main);
+
+    for (size_t j = i + 1; j < NUM_THREADS; j++) {
+      EXPECT_NE(rand_bytes[i], rand_bytes[j]);
+    }
+  }
+}
+
+#if RANDOMSHAKE_HAS_FORK_DETECTION
+TEST(RandomSHAKEThreadLocal, Forked_Child_Process_Produces_Ne_Output)
+{
+  constexpr size_t RANDOM_OUTPUT_BYTE_LEN = 64;
+
+  // Make sure the instance exists and fork handler is registered, before forking.
+  static_cast<void>(randomshake::thread_local_csprng());
+  const auto fork_gen_before = randomshake::fork_generation();
+
+  std::array<int, 2> pipe_fds{};
+  ASSERT_EQ(pipe(pipe_fds.data()), 0);
+
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+
+  if (pid == 0) {
+    std::array<uint8_t, RANDOM_OUTPUT_BYTE_LEN> child_bytes{};
+    randomshake::thread_local_csprng().generate(child_bytes);
+
+    const bool fork_detected = randomshake::fork_generation() == (fork_gen_before + 1);
+    const auto written = write(pipe_fds[1], child_bytes.data(), child_bytes.size());
+    _exit((fork_detected && (written == static_cast<ssize_t>(child_bytes.size()))) ? 0 : 1);
+  }
+
+  std::array<uint8_t, RANDOM_OUTPUT_BYTE_LEN> parent_bytes{};
+  randomshake::thread_local_csprng().generate(parent_bytes);
+
+  std::array<uint8_t, RANDOM_OUTPUT_BYTE_LEN> child_bytes{};
+  const auto read_byte_len = read(pipe_fds[0], child_bytes.data(), child_bytes.size());
+
+  int child_status = 0;
+  waitpid(pid, &child_status, 0);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+
+  ASSERT_TRUE(WIFEXITED(child_status));
+  ASSERT_EQ(WEXITSTATUS(child_status), 0);
+  ASSERT_EQ(read_byte_len, static_cast<ssize_t>(child_bytes.size()));
+
+  EXPECT_EQ(randomshake::fork_generation(), fork_gen_before);
+  EXPECT_NE(parent_bytes, child_bytes);
+}
+#endif
@@ -0,0 +1,176 @@
+#include "randomshake/generate_parallel.hpp"
+#include "randomshake/randomshake.hpp"
+#include "randomshake/tree_xof.hpp"
+#include "test_consts.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+namespace {
+
+using tree_csprng_t = randomshake::randomshake_t<uint8_t, randomshake::xof_kind_t::TURBOSHAKE256_TREE>;
+using tree_selector_t = randomshake::xof_selector_t<randomshake::xof_kind_t::TURBOSHAKE256_TREE>;
+
+constexpr size_t LEAF_RATE_BYTE_LEN = turboshake256::RATE / 8;
+constexpr size_t NUM_LEAVES = tree_selector_t::num_leaves;
+
+/**
+ * First 32 -bytes of the output stream of leaf 0 and leaf 7, for a seed filled with 0xde. These are the first 32 -bytes of
+ * TurboSHAKE256(DOMAIN || CV || LE64(leaf_idx)), where CV is first 64 -bytes of TurboSHAKE256(SEED), computed independently of
+ * this library. As stripes start with a block from leaf 0, CSPRNG output stream must start with the first one.
+ */
+constexpr std::array<uint8_t, 32> KAT_LEAF_0 = { 0x42, 0x6c, 0x34, 0xb4, 0x32, 0x9d, 0x5f, 0x6c, 0x05, 0x02, 0x72, 0x2e, 0xa8, 0x9b, 0x2f, 0x3b,
+                                                 0xb1, 0x14, 0x52, 0x74, 0x0c, 0x96, 0x9d, 0xe1, 0x07, 0x85, 0x6a, 0x7d, 0x2a, 0x49, 0x69, 0x1f };
+constexpr std::array<uint8_t, 32> KAT_LEAF_7 = { 0x5a, 0xc1, 0x91, 0xbb, 0x5e, 0x07, 0xa7, 0x32, 0xbf, 0x88, 0xce, 0x97, 0x31, 0xd0, 0x3c, 0xb2,
+                                                 0x80, 0xc9, 0x87, 0x55, 0x83, 0x49, 0x20, 0xc8, 0x85, 0xde, 0xaa, 0x83, 0x5a, 0x37, 0xa9, 0x02 };
+
+// Initializes all leaf sponges, the same way `tree_xof_t::finalize` is expected to.
+std::array<turboshake256::turboshake256_t, NUM_LEAVES>
+make_leaves(std::span<const uint8_t, tree_csprng_t::seed_byte_len> seed)
+{
+  turboshake256::turboshake256_t root{};
+  root.reset();
+  root.absorb(seed);
+  root.finalize();
+
+  std::array<uint8_t, 64> chaining_value{};
+  root.squeeze(chaining_value);
+
+  std::array<turboshake256::turboshake256_t, NUM_LEAVES> leaves{};
+  for (size_t leaf_idx = 0; leaf_idx < NUM_LEAVES; leaf_idx++) {
+    const auto leaf_idx_le64 = static_cast<uint64_t>(leaf_idx);
+    std::array<uint8_t, sizeof(leaf_idx_le64)> leaf_idx_bytes{};
+    std::memcpy(leaf_idx_bytes.data(), &leaf_idx_le64, sizeof(leaf_idx_le64));
+
+    leaves[leaf_idx].reset();
+    leaves[leaf_idx].absorb(randomshake::TREE_XOF_LEAF_DOMAIN);
+    leaves[leaf_idx].absorb(chaining_value);
+    leaves[leaf_idx].absorb(leaf_idx_bytes);
+    leaves[leaf_idx].finalize();
+  }
+
+  return leaves;
+}
+
+}
+
+TEST(RandomSHAKETreeXOF, Known_Answer_Tests)
+{
+  std::array<uint8_t, tree_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  tree_csprng_t csprng(seed);
+
+  std::vector<uint8_t> computed(tree_selector_t::type::stripe_byte_len, 0);
+  csprng.generate(computed);
+
+  EXPECT_TRUE(std::ranges::equal(std::span(computed).first<32>(), KAT_LEAF_0));
+  EXPECT_TRUE(std::ranges::equal(std::span(computed).subspan((NUM_LEAVES - 1) * LEAF_RATE_BYTE_LEN, 32), KAT_LEAF_7));
+}
+
+TEST(RandomSHAKETreeXOF, Output_Is_Leaf_Blocks_Interleaved_In_Stripe_Order)
+{
+  std::array<uint8_t, tree_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  // Spans three ratchet periods, with a partial stripe at the end, to cover ratcheting of every leaf.
+  constexpr size_t num_stripes = 3 * (tree_csprng_t::ratchet_period_byte_len / tree_selector_t::type::stripe_byte_len);
+  constexpr size_t output_byte_len = num_stripes * tree_selector_t::type::stripe_byte_len + LEAF_RATE_BYTE_LEN + 17;
+
+  std::vector<uint8_t> computed(output_byte_len, 0x00);
+  tree_csprng_t csprng(seed);
+  csprng.generate(std::span(computed).first(output_byte_len / 2));
+  csprng.generate(std::span(computed).subspan(output_byte_len / 2));
+
+  auto leaves = make_leaves(seed);
+  std::vector<uint8_t> expected(output_byte_len + tree_selector_t::type::stripe_byte_len, 0xff);
+
+  constexpr size_t stripes_per_ratchet_period = tree_csprng_t::ratchet_period_byte_len / tree_selector_t::type::stripe_byte_len;
+  for (size_t stripe_idx = 0; stripe_idx <= num_stripes; stripe_idx++) {
+    if ((stripe_idx != 0) && (stripe_idx % stripes_per_ratchet_period == 0)) {
+      for (auto& leaf : leaves) {
+        leaf.ratchet(tree_selector_t::ratchet_byte_len);
+      }
+    }
+
+    for (size_t leaf_idx = 0; leaf_idx < NUM_LEAVES; leaf_idx++) {
+      const size_t block_offset = stripe_idx * tree_selector_t::type::stripe_byte_len + leaf_idx * LEAF_RATE_BYTE_LEN;
+      leaves[leaf_idx].squeeze(std::span(expected).subspan(block_offset, LEAF_RATE_BYTE_LEN));
+    }
+  }
+
+  expected.resize(output_byte_len);
+  EXPECT_EQ(computed, expected);
+}
+
+TEST(RandomSHAKETreeXOF, Scalar_And_Bulk_Generation_Produce_Eq_Output)
+{
+  std::array<uint8_t, tree_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::vector<uint8_t> scalar_bytes(GENERATED_RANDOM_BYTE_LEN, 0x00);
+  std::vector<uint8_t> bulk_bytes(GENERATED_RANDOM_BYTE_LEN, 0xff);
+
+  tree_csprng_t csprng_a(seed);
+  std::ranges::generate(scalar_bytes, [&]() { return csprng_a(); });
+
+  tree_csprng_t csprng_b(seed);
+  csprng_b.generate(bulk_bytes);
+
+  EXPECT_EQ(scalar_bytes, bulk_bytes);
+
+  std::vector<uint64_t> typed_words(GENERATED_RANDOM_BYTE_LEN / sizeof(uint64_t), 0);
+  randomshake::randomshake_t<uint64_t, randomshake::xof_kind_t::TURBOSHAKE256_TREE> csprng_c(seed);
+  csprng_c.generate(std::span(typed_words));
+
+  std::vector<uint8_t> typed_bytes(typed_words.size() * sizeof(uint64_t), 0);
+  std::memcpy(typed_bytes.data(), typed_words.data(), typed_bytes.size());
+  EXPECT_TRUE(std::ranges::equal(typed_bytes, std::span(bulk_bytes).first(typed_bytes.size())));
+}
+
+TEST(RandomSHAKETreeXOF, Generate_Parallel_Fills_Chunks_From_Subtrees)
+{
+  std::array<uint8_t, tree_csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  // Chunks don't end on stripe boundaries, so that each subtree is left with unread bytes of its last stripe.
+  constexpr size_t chunk_byte_len = 3 * tree_selector_t::type::stripe_byte_len + 5;
+  constexpr size_t output_byte_len = 4 * chunk_byte_len + 11;
+
+  std::vector<uint8_t> computed(output_byte_len, 0x00);
+  {
+    tree_csprng_t csprng(seed);
+    randomshake::generate_parallel(csprng, std::span(computed), randomshake::std_thread_executor_t{ 3 }, chunk_byte_len);
+  }
+
+  // Reproduce the output, by squeezing the child key and driving the subtree of each chunk by hand.
+  std::array<uint8_t, tree_csprng_t::seed_byte_len> child_key{};
+  {
+    tree_csprng_t csprng(seed);
+    csprng.generate(child_key);
+  }
+
+  std::vector<uint8_t> expected(output_byte_len, 0xff);
+  auto expected_span = std::span(expected);
+
+  for (uint64_t chunk_idx = 0; chunk_idx * chunk_byte_len < output_byte_len; chunk_idx++) {
+    std::array<uint8_t, sizeof(chunk_idx)> chunk_idx_bytes{};
+    std::memcpy(chunk_idx_bytes.data(), &chunk_idx, sizeof(chunk_idx));
+
+    tree_selector_t::type subtree{};
+    subtree.reset();
+    subtree.absorb(randomshake::GENERATE_PARALLEL_DOMAIN);
+    subtree.absorb(child_key);
+    subtree.absorb(chunk_idx_bytes);
+    subtree.finalize();
+
+    const size_t chunk_offset = chunk_idx * chunk_byte_len;
+    subtree.squeeze(expected_span.subspan(chunk_offset, std::min(chunk_byte_len, output_byte_len - chunk_offset)));
+  }
+
+  EXPECT_EQ(computed, expected);
+}
@@ -0,0 +1,114 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/uniform_int.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace {
+
+template<typename T>
+void
+test_uniform_int_fill_stays_within_interval(const T lo, const T hi)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<T> values(1'024 * 16, 0);
+  randomshake::uniform_int_fill(csprng, std::span(values), lo, hi);
+
+  EXPECT_TRUE(std::ranges::all_of(values, [&](const T val) { return (lo <= val) && (val <= hi); }));
+}
+
+}
+
+TEST(RandomSHAKEUniformInt, Sampled_Values_Stay_Within_Interval)
+{
+  test_uniform_int_fill_stays_within_interval<uint8_t>(97, 102);
+  test_uniform_int_fill_stays_within_interval<uint8_t>(0, std::numeric_limits<uint8_t>::max());
+  test_uniform_int_fill_stays_within_interval<uint16_t>(1, 6);
+  test_uniform_int_fill_stays_within_interval<uint32_t>(0, 1'000'000'006);
+  test_uniform_int_fill_stays_within_interval<uint32_t>(0, std::numeric_limits<uint32_t>::max());
+  test_uniform_int_fill_stays_within_interval<uint64_t>(1'000, (1ULL << 63) + 12'345);
+  test_uniform_int_fill_stays_within_interval<uint64_t>(0, std::numeric_limits<uint64_t>::max());
+  test_uniform_int_fill_stays_within_interval<int8_t>(-100, 100);
+  test_uniform_int_fill_stays_within_interval<int32_t>(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+  test_uniform_int_fill_stays_within_interval<int64_t>(-5, -3);
+  test_uniform_int_fill_stays_within_interval<uint16_t>(42, 42);
+}
+
+TEST(RandomSHAKEUniformInt, Power_Of_Two_Interval_Maps_Words_By_Multiply_Shift)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng_words(seed);
+  randomshake::randomshake_t csprng_sampled(seed);
+
+  // When interval width is a power of 2, no word is ever rejected, so i-th sampled value must be i-th word's top bits.
+  constexpr size_t NUM_VALUES = 10'000;
+  constexpr uint32_t LO = 10;
+  constexpr uint32_t HI = LO + 1'023;
+
+  std::vector<uint32_t> words(NUM_VALUES, 0);
+  csprng_words.generate(std::span(words));
+
+  std::vector<uint32_t> sampled(NUM_VALUES, 0);
+  randomshake::uniform_int_fill(csprng_sampled, std::span(sampled), LO, HI);
+
+  std::vector<uint32_t> expected(NUM_VALUES, 0);
+  std::ranges::transform(words, expected.begin(), [](const uint32_t word) { return LO + (word >> 22); });
+
+  EXPECT_EQ(expected, sampled);
+}
+
+TEST(RandomSHAKEUniformInt, Sampled_Values_Are_Roughly_Uniformly_Distributed)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+
+  constexpr size_t NUM_BUCKETS = 6;
+  constexpr size_t NUM_VALUES = NUM_BUCKETS * 100'000;
+
+  std::vector<uint16_t> values(NUM_VALUES, 0);
+  randomshake::uniform_int_fill(csprng, std::span(values), 1, NUM_BUCKETS);
+
+  std::array<size_t, NUM_BUCKETS> histogram{};
+  for (const auto val : values) {
+    histogram[val - 1]++;
+  }
+
+  // Expected count per bucket is 100,000, with standard deviation of ~370. Allow for a generous error margin.
+  for (const auto count : histogram) {
+    EXPECT_GT(count, 98'000U);
+    EXPECT_LT(count, 102'000U);
+  }
+}
+
+TEST(RandomSHAKEUniformInt, Deterministic_CSPRNG_Using_Same_Seed_Produces_Eq_Output)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng_a(seed);
+  randomshake::randomshake_t csprng_b(seed);
+
+  // Interval width, just above 2^31, maximizes rejection rate, exercising the rejection pass.
+  constexpr uint32_t HI = (1U << 31) + 1;
+
+  std::vector<uint32_t> values_a(1'024 * 16, 0);
+  std::vector<uint32_t> values_b(1'024 * 16, 1);
+
+  randomshake::uniform_int_fill(csprng_a, std::span(values_a), 0, HI);
+  randomshake::uniform_int_fill(csprng_b, std::span(values_b), 0, HI);
+
+  EXPECT_EQ(values_a, values_b);
+  EXPECT_TRUE(std::ranges::all_of(values_a, [](const uint32_t val) { return val <= HI; }));
+}
@@ -0,0 +1,94 @@
+#include "randomshake/randomshake.hpp"
+#include "randomshake/uniform_real.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace {
+
+template<typename F>
+void
+test_uniform_real_fill_stays_within_interval(const F lo, const F hi)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t csprng(seed);
+
+  std::vector<F> values(1'024 * 16, 0);
+  randomshake::uniform_real_fill(csprng, std::span(values), lo, hi);
+
+  EXPECT_TRUE(std::ranges::all_of(values, [&](const F val) { return (lo <= val) && (val < hi); }));
+}
+
+}
+
+TEST(RandomSHAKEUniformReal, Sampled_Values_Stay_Within_Interval)
+{
+  test_uniform_real_fill_stays_within_interval<float>(0.F, 1.F);
+  test_uniform_real_fill_stays_within_interval<float>(-1.F, 1.F);
+  test_uniform_real_fill_stays_within_interval<float>(1.F, 1.0000001F);
+  test_uniform_real_fill_stays_within_interval<double>(0., 1.);
+  test_uniform_real_fill_stays_within_interval<double>(-1e9, 1e-9);
+  test_uniform_real_fill_stays_within_interval<double>(5., 5.000000000000001);
+}
+
+TEST(RandomSHAKEUniformReal, Unit_Interval_Values_Are_Built_From_Top_Bits_Of_Words)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  constexpr size_t NUM_VALUES = 10'000;
+
+  {
+    randomshake::randomshake_t csprng_words(seed);
+    randomshake::randomshake_t csprng_sampled(seed);
+
+    std::vector<uint32_t> words(NUM_VALUES, 0);
+    csprng_words.generate(std::span(words));
+
+    std::vector<float> sampled(NUM_VALUES, 0);
+    randomshake::uniform_real_fill(csprng_sampled, std::span(sampled));
+
+    for (size_t i = 0; i < NUM_VALUES; i++) {
+      EXPECT_EQ(sampled[i], std::ldexp(static_cast<float>(words[i] >> 8), -24));
+    }
+  }
+
+  {
+    randomshake::randomshake_t csprng_words(seed);
+    randomshake::randomshake_t csprng_sampled(seed);
+
+    std::vector<uint64_t> words(NUM_VALUES, 0);
+    csprng_words.generate(std::span(words));
+
+    std::vector<double> sampled(NUM_VALUES, 0);
+    randomshake::uniform_real_fill(csprng_sampled, std::span(sampled));
+
+    for (size_t i = 0; i < NUM_VALUES; i++) {
+      EXPECT_EQ(sampled[i], std::ldexp(static_cast<double>(words[i] >> 11), -53));
+    }
+  }
+}
+
+TEST(RandomSHAKEUniformReal, Sampled_Values_Have_Expected_Mean)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint64_t> csprng(seed);
+
+  constexpr size_t NUM_VALUES = 1'000'000;
+
+  std::vector<double> values(NUM_VALUES, 0);
+  randomshake::uniform_real_fill(csprng, std::span(values), -2., 6.);
+
+  // Mean of U[-2, 6) is 2, with variance 16/3. So standard error of the sample mean is ~0.0023.
+  const double mean = std::accumulate(values.begin(), values.end(), 0.) / static_cast<double>(NUM_VALUES);
+  EXPECT_NEAR(mean, 2., 0.02);
+}
@@ -2,7 +2,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 namespace randomshake_test_utils {
 
@@ -27,4 +29,25 @@ do_bitflip(uint8_t& val, const size_t bit_idx)
   val = static_cast<uint8_t>((val & hi_bit_mask) ^ (selected_bit_flipped << bit_idx) ^ (val & lo_bit_mask));
 }
 
+/**
+ * Bulk generator, which serves given words, over and over again, instead of pseudo-random ones. Lets tests pin down the
+ * exact words consumed by a sampler, and timing tests isolate the sampler from the CSPRNG.
+ */
+template<typename word_t>
+struct replay_generator_t
+{
+  std::vector<word_t> words{};
+  size_t offset = 0;
+  size_t num_generated_words = 0;
+
+  void generate(std::span<word_t> output)
+  {
+    for (auto& word : output) {
+      word = words[offset];
+      offset = (offset + 1) % words.size();
+    }
+    num_generated_words += output.size();
+  }
+};
+
 }
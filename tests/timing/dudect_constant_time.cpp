@@ -0,0 +1,271 @@
+/**
+ * dudect-style statistical timing test, for the constant-time API surface of RandomSHAKE. See https://eprint.iacr.org/2016/1123.
+ *
+ * For each function under test, execution time is measured many times, over two classes of inputs - class 0 always uses the
+ * same fixed input, while class 1 uses a fresh random input each time. Classes are interleaved at random. If the timing
+ * distributions of the two classes differ, Welch's t-statistic grows with the number of measurements. As dudect does, the
+ * t-test is also run on measurements cropped at a few percentiles, so that the outliers caused by interrupts don't hide a
+ * leak. When the largest |t| exceeds `T_THRESHOLD`, the function is reported as leaking and the test fails.
+ *
+ * Timing depends on the machine and its load, so this is built as a separate target, which is not part of the unit tests.
+ * Build it in Release mode and run it on an idle machine.
+ */
+#include "randomshake/constant_time.hpp"
+#include "randomshake/randomshake.hpp"
+#include "test_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// dudect considers |t| > 10 as a definite timing leak. Values in between 4.5 and 10 are suspicious, but can be noise.
+constexpr double T_THRESHOLD = 10.;
+
+constexpr size_t NUM_MEASUREMENTS = 200'000;
+constexpr size_t NUM_CALLS_PER_MEASUREMENT = 16;
+constexpr std::array<double, 6> CROP_PERCENTILES = { 1., .99, .95, .9, .75, .5 };
+
+// Online mean and variance accumulator, following Welford's method.
+struct welch_accumulator_t
+{
+  std::array<double, 2> mean{};
+  std::array<double, 2> m2{};
+  std::array<double, 2> count{};
+
+  void push(const size_t class_idx, const double val)
+  {
+    count[class_idx] += 1.;
+
+    const double delta = val - mean[class_idx];
+    mean[class_idx] += delta / count[class_idx];
+    m2[class_idx] += delta * (val - mean[class_idx]);
+  }
+
+  [[nodiscard]] double t_statistic() const
+  {
+    if ((count[0] < 2.) || (count[1] < 2.)) {
+      return 0.;
+    }
+
+    const double var0 = m2[0] / (count[0] - 1.);
+    const double var1 = m2[1] / (count[1] - 1.);
+    const double denominator = std::sqrt((var0 / count[0]) + (var1 / count[1]));
+
+    return (denominator == 0.) ? 0. : ((mean[0] - mean[1]) / denominator);
+  }
+};
+
+/**
+ * Copies `fresh` into `input` for class 1 and `fixed` for class 0. Both classes do the same amount of work, while preparing
+ * input, so that caches are in the same state, when the measurement starts.
+ */
+template<typename T>
+void
+select_input(const size_t class_idx, std::span<const T> fixed, std::span<const T> fresh, std::span<T> input)
+{
+  std::ranges::copy((class_idx == 0) ? fixed : fresh, input.begin());
+}
+
+/**
+ * Runs `prepare(class_idx)` before and `run()` between two timestamps, `NUM_MEASUREMENTS` times, returning the largest |t|,
+ * over all cropped sets of measurements.
+ */
+double
+measure_max_abs_t(const std::function<void(size_t)>& prepare, const std::function<void()>& run)
+{
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  randomshake::randomshake_t<uint8_t> class_picker(seed);
+
+  std::vector<uint8_t> classes(NUM_MEASUREMENTS, 0);
+  std::vector<double> timings(NUM_MEASUREMENTS, 0.);
+
+  for (size_t i = 0; i < NUM_MEASUREMENTS; i++) {
+    classes[i] = class_picker() & 1U;
+    prepare(classes[i]);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t j = 0; j < NUM_CALLS_PER_MEASUREMENT; j++) {
+      run();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    timings[i] = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+
+  // First few measurements are taken with cold caches, drop them.
+  constexpr size_t num_warmup_measurements = NUM_MEASUREMENTS / 100;
+
+  std::vector<double> sorted_timings(timings.begin() + num_warmup_measurements, timings.end());
+  std::ranges::sort(sorted_timings);
+
+  double max_abs_t = 0.;
+  for (const auto percentile : CROP_PERCENTILES) {
+    const auto crop_idx = std::min(static_cast<size_t>(percentile * static_cast<double>(sorted_timings.size())), sorted_timings.size() - 1);
+    const double threshold = sorted_timings[crop_idx];
+
+    welch_accumulator_t acc{};
+    for (size_t i = num_warmup_measurements; i < NUM_MEASUREMENTS; i++) {
+      if (timings[i] <= threshold) {
+        acc.push(classes[i], timings[i]);
+      }
+    }
+
+    max_abs_t = std::max(max_abs_t, std::abs(acc.t_statistic()));
+  }
+
+  return max_abs_t;
+}
+
+// Bounded sampling, with fixed vs. random 64-bit words fed to it, over a fixed interval.
+double
+test_uniform_int_ct_fill()
+{
+  constexpr size_t num_values = 32;
+
+  randomshake::randomshake_t<uint64_t> csprng{};
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = std::vector<uint64_t>(2 * num_values, 0) };
+  std::array<uint64_t, num_values> values{};
+
+  const std::vector<uint64_t> fixed_words(2 * num_values, 0);
+  std::vector<uint64_t> fresh_words(2 * num_values, 0);
+
+  const auto prepare = [&](const size_t class_idx) {
+    csprng.generate(std::span(fresh_words));
+    select_input<uint64_t>(class_idx, fixed_words, fresh_words, generator.words);
+  };
+  const auto run = [&]() {
+    randomshake::uniform_int_ct_fill(generator, std::span<uint64_t>(values), uint64_t{ 0 }, (1ULL << 63) + 1);
+    randomshake::DoNotOptimize(values);
+  };
+
+  return measure_max_abs_t(prepare, run);
+}
+
+// Shuffling, with fixed vs. random keys, of fixed vs. random values.
+double
+test_shuffle_ct()
+{
+  constexpr size_t num_values = 64;
+
+  randomshake::randomshake_t<uint64_t> csprng{};
+  randomshake_test_utils::replay_generator_t<uint64_t> generator{ .words = std::vector<uint64_t>(num_values, 0) };
+  std::vector<uint64_t> values(num_values, 0);
+  std::vector<uint64_t> working_copy(num_values, 0);
+
+  const std::vector<uint64_t> fixed_input(num_values, 0);
+  std::vector<uint64_t> fresh_keys(num_values, 0);
+  std::vector<uint64_t> fresh_values(num_values, 0);
+
+  const auto prepare = [&](const size_t class_idx) {
+    csprng.generate(std::span(fresh_keys));
+    csprng.generate(std::span(fresh_values));
+
+    select_input<uint64_t>(class_idx, fixed_input, fresh_keys, generator.words);
+    select_input<uint64_t>(class_idx, fixed_input, fresh_values, values);
+  };
+  const auto run = [&]() {
+    std::ranges::copy(values, working_copy.begin());
+    randomshake::shuffle_ct(generator, std::span(working_copy));
+    randomshake::DoNotOptimize(working_copy);
+  };
+
+  return measure_max_abs_t(prepare, run);
+}
+
+// Seeding and squeezing from RandomSHAKE CSPRNG, with fixed vs. random seed.
+double
+test_randomshake_squeeze()
+{
+  randomshake::randomshake_t<uint64_t> csprng{};
+
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> seed{};
+  std::array<uint64_t, 32> values{};
+
+  const std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> fixed_seed{};
+  std::array<uint8_t, randomshake::randomshake_t<>::seed_byte_len> fresh_seed{};
+
+  const auto prepare = [&](const size_t class_idx) {
+    csprng.generate(fresh_seed);
+    select_input<uint8_t>(class_idx, fixed_seed, fresh_seed, seed);
+  };
+  const auto run = [&]() {
+    randomshake::randomshake_t<uint64_t> csprng_under_test(seed);
+    csprng_under_test.generate(std::span<uint64_t>(values));
+    randomshake::DoNotOptimize(values);
+  };
+
+  return measure_max_abs_t(prepare, run);
+}
+
+// Drawing single values with `randomshake_t::next_ct`, starting at a fixed vs. random position in the buffer. From a random
+// position, some of the draws need the next ratchet period or straddle it, which the functor would take longer for.
+double
+test_randomshake_next_ct()
+{
+  using csprng_t = randomshake::randomshake_t<uint64_t>;
+
+  csprng_t csprng{};
+
+  std::array<uint8_t, csprng_t::seed_byte_len> seed{};
+  seed.fill(0xde);
+
+  std::optional<csprng_t> csprng_under_test{};
+  std::array<uint8_t, csprng_t::ratchet_period_byte_len> skipped_bytes{};
+  uint64_t value = 0;
+
+  const auto prepare = [&](const size_t class_idx) {
+    const auto fresh_position = static_cast<size_t>(csprng() % skipped_bytes.size());
+    const size_t position = (class_idx == 0) ? 0 : fresh_position;
+
+    csprng_under_test.emplace(seed);
+    csprng_under_test->generate(std::span(skipped_bytes).first(position));
+  };
+  const auto run = [&]() {
+    value = csprng_under_test->next_ct();
+    randomshake::DoNotOptimize(value);
+  };
+
+  return measure_max_abs_t(prepare, run);
+}
+
+}
+
+int
+main()
+{
+  struct timing_test_t
+  {
+    std::string_view name;
+    double (*run)();
+  };
+
+  constexpr std::array<timing_test_t, 4> timing_tests = { {
+    { "uniform_int_ct_fill", &test_uniform_int_ct_fill },
+    { "shuffle_ct", &test_shuffle_ct },
+    { "randomshake_t::generate", &test_randomshake_squeeze },
+    { "randomshake_t::next_ct", &test_randomshake_next_ct },
+  } };
+
+  bool is_leak_detected = false;
+  for (const auto& timing_test : timing_tests) {
+    const double max_abs_t = timing_test.run();
+    const bool is_leaking = max_abs_t > T_THRESHOLD;
+
+    std::cout << (is_leaking ? "[LEAK] " : "[OK]   ") << timing_test.name << ": max |t| = " << max_abs_t << '\n';
+    is_leak_detected |= is_leaking;
+  }
+
+  return is_leak_detected ? EXIT_FAILURE : EXIT_SUCCESS;
+}